@@ -0,0 +1,226 @@
+#include "core/api_json.hpp"
+
+#include <algorithm>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+
+namespace core {
+
+using nlohmann::json;
+
+json RelationshipsToJson(const RelationshipGraph& graph) {
+  json outgoing = json::array();
+  for (const auto& edge : graph.outgoing) {
+    outgoing.push_back({{"predicate", edge.predicate}, {"target", edge.target}});
+  }
+  json incoming = json::array();
+  for (const auto& edge : graph.incoming) {
+    incoming.push_back({{"predicate", edge.predicate}, {"source", edge.target}});
+  }
+  return {{"outgoing", outgoing}, {"incoming", incoming}};
+}
+
+namespace {
+
+struct FieldName {
+  SlugField field;
+  const char* name;
+};
+
+constexpr FieldName kFieldNames[] = {
+    {kSlugFieldChecklist, "checklist"},
+    {kSlugFieldSection, "section"},
+    {kSlugFieldProcedure, "procedure"},
+    {kSlugFieldAction, "action"},
+    {kSlugFieldSpec, "spec"},
+    {kSlugFieldResult, "result"},
+    {kSlugFieldStatus, "status"},
+    {kSlugFieldComment, "comment"},
+    {kSlugFieldTimestamp, "timestamp"},
+    {kSlugFieldInstructions, "instructions"},
+    {kSlugFieldRelationships, "relationships"},
+};
+
+}  // namespace
+
+json SlugToJson(const ChecklistSlug& slug, std::uint32_t fields) {
+  json payload = {{"address_id", slug.address_id}};
+  const auto put = [&](SlugField field, const char* name, json value) {
+    if (fields & field) {
+      payload[name] = std::move(value);
+    }
+  };
+  put(kSlugFieldChecklist, "checklist", slug.checklist);
+  put(kSlugFieldSection, "section", slug.section);
+  put(kSlugFieldProcedure, "procedure", slug.procedure);
+  put(kSlugFieldAction, "action", slug.action);
+  put(kSlugFieldSpec, "spec", slug.spec);
+  put(kSlugFieldResult, "result", slug.result);
+  put(kSlugFieldStatus, "status", StatusToString(slug.status));
+  put(kSlugFieldComment, "comment", slug.comment);
+  put(kSlugFieldTimestamp, "timestamp", slug.timestamp);
+  put(kSlugFieldInstructions, "instructions", slug.instructions);
+  if (fields & kSlugFieldRelationships) {
+    json relationships = json::array();
+    for (const auto& edge : slug.relationships) {
+      relationships.push_back({{"predicate", edge.predicate}, {"target", edge.target}});
+    }
+    payload["relationships"] = std::move(relationships);
+  }
+  return payload;
+}
+
+std::uint32_t ParseSlugFields(const std::string& list) {
+  std::uint32_t fields = 0;
+  std::size_t start = 0;
+  while (start <= list.size()) {
+    const auto end = std::min(list.find(',', start), list.size());
+    const auto name = list.substr(start, end - start);
+    start = end + 1;
+    if (name.empty() || name == "address_id") {
+      continue;
+    }
+    const auto it = std::find_if(std::begin(kFieldNames), std::end(kFieldNames),
+                                 [&](const FieldName& entry) { return name == entry.name; });
+    if (it == std::end(kFieldNames)) {
+      throw std::invalid_argument("Unknown field '" + name + "'.");
+    }
+    fields |= it->field;
+  }
+  return fields;
+}
+
+SlugUpdate ParseUpdatePayload(const json& payload) {
+  if (!payload.is_object()) {
+    throw std::invalid_argument("Payload must be a JSON object.");
+  }
+  const auto it = payload.find("address_id");
+  if (it == payload.end() || !it->is_string()) {
+    throw std::invalid_argument("Field 'address_id' is required and must be a string.");
+  }
+
+  SlugUpdate update;
+  update.address_id = it->get<std::string>();
+
+  if (const auto result_it = payload.find("result"); result_it != payload.end() &&
+                                                     (result_it->is_string() || result_it->is_null())) {
+    update.result = result_it->is_null() ? std::string{} : result_it->get<std::string>();
+  }
+
+  if (const auto status_it = payload.find("status"); status_it != payload.end()) {
+    if (!status_it->is_string()) {
+      throw std::invalid_argument("Field 'status' must be a string when provided.");
+    }
+    const auto status = ParseStatus(status_it->get<std::string>());
+    if (status == ChecklistStatus::kUnknown) {
+      throw std::invalid_argument("Status must be Pass, Fail, NA, or Other.");
+    }
+    update.status = status;
+  }
+
+  if (const auto comment_it = payload.find("comment");
+      comment_it != payload.end() && (comment_it->is_string() || comment_it->is_null())) {
+    update.comment = comment_it->is_null() ? std::string{} : comment_it->get<std::string>();
+  }
+
+  if (const auto ts_it = payload.find("timestamp"); ts_it != payload.end()) {
+    if (!ts_it->is_string()) {
+      throw std::invalid_argument("Field 'timestamp' must be a string when provided.");
+    }
+    update.timestamp = ts_it->get<std::string>();
+  }
+
+  return update;
+}
+
+std::vector<SlugUpdate> ParseBulkPayload(const json& payload) {
+  if (!payload.is_array()) {
+    throw std::invalid_argument("Bulk payload must be a JSON array.");
+  }
+  std::vector<SlugUpdate> updates;
+  for (const auto& item : payload) {
+    updates.push_back(ParseUpdatePayload(item));
+  }
+  return updates;
+}
+
+namespace {
+
+std::string RequiredString(const json& record, const char* field) {
+  const auto it = record.find(field);
+  if (it == record.end() || !it->is_string()) {
+    throw std::invalid_argument(std::string{"Field '"} + field +
+                                "' is required and must be a string.");
+  }
+  return it->get<std::string>();
+}
+
+std::string OptionalString(const json& record, const char* field) {
+  const auto it = record.find(field);
+  if (it == record.end() || it->is_null()) {
+    return {};
+  }
+  if (!it->is_string()) {
+    throw std::invalid_argument(std::string{"Field '"} + field +
+                                "' must be a string when provided.");
+  }
+  return it->get<std::string>();
+}
+
+}  // namespace
+
+ChecklistSlug ParseSlugRecord(const json& record) {
+  if (!record.is_object()) {
+    throw std::invalid_argument("Record must be a JSON object.");
+  }
+
+  ChecklistSlug slug;
+  slug.checklist = RequiredString(record, "checklist");
+  slug.section = RequiredString(record, "section");
+  slug.procedure = RequiredString(record, "procedure");
+  slug.action = RequiredString(record, "action");
+  slug.spec = RequiredString(record, "spec");
+  if (slug.checklist.empty()) {
+    throw std::invalid_argument("Field 'checklist' must not be empty.");
+  }
+  slug.address_id =
+      ComputeAddressId(slug.checklist, slug.section, slug.procedure, slug.action, slug.spec);
+
+  const auto supplied_id = OptionalString(record, "address_id");
+  if (!supplied_id.empty() && supplied_id != slug.address_id) {
+    throw std::invalid_argument("address_id " + supplied_id +
+                                " does not match content (expected " + slug.address_id + ").");
+  }
+
+  const auto status = OptionalString(record, "status");
+  slug.status = ParseStatus(status);
+  if (slug.status == ChecklistStatus::kUnknown && !status.empty() && status != "Unknown") {
+    throw std::invalid_argument("Status must be Pass, Fail, NA, Other, or Unknown.");
+  }
+
+  slug.result = OptionalString(record, "result");
+  slug.comment = OptionalString(record, "comment");
+  slug.instructions = OptionalString(record, "instructions");
+  slug.timestamp = OptionalString(record, "timestamp");
+  if (slug.timestamp.empty()) {
+    slug.timestamp = CurrentTimestampIsoUtc();
+  }
+
+  if (const auto it = record.find("relationships"); it != record.end() && !it->is_null()) {
+    if (!it->is_array()) {
+      throw std::invalid_argument("Field 'relationships' must be an array when provided.");
+    }
+    for (const auto& edge : *it) {
+      if (!edge.is_object()) {
+        throw std::invalid_argument("Relationship entries must be objects.");
+      }
+      slug.relationships.push_back(
+          {RequiredString(edge, "predicate"), RequiredString(edge, "target")});
+    }
+  }
+
+  return slug;
+}
+
+}  // namespace core
@@ -0,0 +1,23 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "core/checklist_store.hpp"
+#include "nlohmann/json.hpp"
+
+namespace core {
+
+nlohmann::json RelationshipsToJson(const RelationshipGraph& graph);
+// `fields` is a SlugField mask; address_id is always emitted.
+nlohmann::json SlugToJson(const ChecklistSlug& slug, std::uint32_t fields = kAllSlugFields);
+// Comma-separated field names, e.g. "status,result"; throws std::invalid_argument on unknown names.
+std::uint32_t ParseSlugFields(const std::string& list);
+SlugUpdate ParseUpdatePayload(const nlohmann::json& payload);
+std::vector<SlugUpdate> ParseBulkPayload(const nlohmann::json& payload);
+// Inverse of SlugToJson. The Address ID is recomputed from the content fields; a supplied
+// `address_id` that does not match is rejected rather than silently re-keyed.
+ChecklistSlug ParseSlugRecord(const nlohmann::json& record);
+
+}  // namespace core
@@ -1,16 +1,26 @@
 #include "core/app.hpp"
 
+#include <algorithm>
+#include <cctype>
 #include <chrono>
 #include <cstdlib>
+#include <memory>
+#include <mutex>
+#include <optional>
 #include <sstream>
 #include <stdexcept>
 #include <string>
 #include <string_view>
 #include <vector>
 
+#include "core/api_json.hpp"
 #include "core/checklist_markdown.hpp"
 #include "core/checklist_store.hpp"
+#include "core/jsonl_import.hpp"
 #include "core/logging.hpp"
+#include "core/mcp_bridge.hpp"
+#include "core/single_flight.hpp"
+#include "core/snapshot.hpp"
 #include "nlohmann/json.hpp"
 #include "platform/http_server.hpp"
 
@@ -21,6 +31,11 @@ using core::logging::LogInfo;
 using core::logging::LogWarn;
 using nlohmann::json;
 
+constexpr std::size_t kMaxHistoryLimit = 1000;
+constexpr std::size_t kMaxPageLimit = 10000;
+constexpr std::size_t kMaxSearchLimit = 100;
+constexpr std::size_t kMaxBatchSlugs = 1000;
+
 struct DemoCommand {
   std::string_view method;
   std::string_view path;
@@ -30,29 +45,50 @@ struct DemoCommand {
 const std::vector<DemoCommand> kCommandCatalog = {
     {"GET", "/api/commands", "List every API command exposed by the server."},
     {"GET", "/api/health", "Report server readiness, uptime, and version."},
+    {"GET", "/api/metrics", "Report store lock, WAL checkpoint, and slug cache stats."},
     {"GET", "/api/hello", "Send a greeting back. Optional query parameter 'name'."},
     {"POST", "/api/echo", "Echo the provided payload for integration smoke tests."},
     {"GET", "/api/checklists", "List available checklist slugs in the runtime store."},
     {"GET", "/api/slug/<address_id>", "Return a single checklist slug by Address ID."},
-    {"GET", "/api/checklist/<checklist>", "Return every slug for the named checklist."},
+    {"POST", "/api/slugs", "Return many slugs by Address ID in one read; unknown IDs are listed."},
+    {"GET", "/api/checklist/<checklist>?fields=<a,b>&status=<s>&limit=<n>&cursor=<cursor>",
+     "Return the named checklist's slugs; optionally projected, filtered and paged."},
     {"GET", "/api/relationships/<address_id>",
      "Return incoming and outgoing relationships for a slug by Address ID."},
+    {"GET", "/api/history/<address_id>?from=<ts>&to=<ts>&limit=<n>",
+     "Return a slug's update history, newest first, within an optional time range."},
+    {"GET", "/api/summary?level=<checklist|section|procedure>&checklist=<name>",
+     "Return maintained Pass/Fail/NA/Other/Unknown counts per hierarchy node."},
+    {"GET", "/api/search?q=<words>&checklist=<a,b>&limit=<n>",
+     "Rank slugs by words in their action, spec, and instructions."},
     {"PATCH", "/api/update", "Apply a minimal state update to a single slug."},
     {"PATCH", "/api/update_bulk", "Apply minimal state updates to multiple slugs."},
-    {"GET", "/api/export/json", "Export all slugs as a JSON array."},
-    {"GET", "/api/export/jsonl", "Export all slugs as JSON Lines."},
+    {"GET", "/api/export/json?fields=<a,b>&status=<s>&limit=<n>&cursor=<cursor>",
+     "Export all slugs as a JSON array; paged exports set X-Next-Cursor."},
+    {"GET", "/api/export/jsonl?fields=<a,b>&status=<s>&limit=<n>&cursor=<cursor>",
+     "Export all slugs as JSON Lines; paged exports set X-Next-Cursor."},
     {"GET", "/api/export/markdown/<checklist>",
      "Export a checklist as canonical Markdown for authors."},
     {"POST", "/api/import/markdown?checklist=<name>",
      "Import Markdown for a checklist and replace its runtime state."},
+    {"POST", "/api/snapshot?name=<file>",
+     "Write an online binary backup of the store into the snapshot directory."},
+    {"POST", "/api/import/jsonl?batch_size=<n>",
+     "Stream export/jsonl records back in; upserts in batched transactions, per-line errors."},
+    {"POST", "/mcp",
+     "MCP JSON-RPC endpoint; tools/call dispatches to these handlers in-process."},
 };
 
 const auto kServerStart = std::chrono::steady_clock::now();
 
+std::mutex startup_mutex;
+StartupReport startup_report;
+
 void ApplyCors(platform::HttpResponse& response) {
   response.headers["Access-Control-Allow-Origin"] = "*";
   response.headers["Access-Control-Allow-Methods"] = "GET,POST,PATCH,OPTIONS";
   response.headers["Access-Control-Allow-Headers"] = "Content-Type";
+  response.headers["Access-Control-Expose-Headers"] = "X-Next-Cursor";
 }
 
 platform::HttpResponse JsonResponse(const json& body, int status = 200) {
@@ -86,90 +122,199 @@ std::string GetQueryParam(const platform::HttpRequest& request, const std::strin
   return fallback;
 }
 
-json RelationshipsToJson(const RelationshipGraph& graph) {
-  json outgoing = json::array();
-  for (const auto& edge : graph.outgoing) {
-    outgoing.push_back({{"predicate", edge.predicate}, {"target", edge.target}});
+std::string UpperCase(std::string value) {
+  for (auto& c : value) {
+    c = static_cast<char>(std::toupper(static_cast<unsigned char>(c)));
   }
-  json incoming = json::array();
-  for (const auto& edge : graph.incoming) {
-    incoming.push_back({{"predicate", edge.predicate}, {"source", edge.target}});
+  return value;
+}
+
+// Listing endpoints keep their full, cache-served response unless one of these is present.
+bool HasSlugQueryParams(const platform::HttpRequest& request) {
+  for (const char* key : {"fields", "status", "limit", "cursor"}) {
+    if (request.query_params.count(key) > 0) {
+      return true;
+    }
   }
-  return {{"outgoing", outgoing}, {"incoming", incoming}};
+  return false;
 }
 
-json SlugToJson(const ChecklistSlug& slug) {
-  json relationships = json::array();
-  for (const auto& edge : slug.relationships) {
-    relationships.push_back({{"predicate", edge.predicate}, {"target", edge.target}});
+// Throws std::invalid_argument on malformed parameters.
+SlugQuery ParseSlugQuery(const platform::HttpRequest& request) {
+  SlugQuery query;
+  if (const auto it = request.query_params.find("fields"); it != request.query_params.end()) {
+    query.fields = ParseSlugFields(it->second);
+  }
+  const std::string statuses = GetQueryParam(request, "status", "");
+  std::size_t start = 0;
+  while (start < statuses.size()) {
+    const auto end = std::min(statuses.find(',', start), statuses.size());
+    const auto name = statuses.substr(start, end - start);
+    start = end + 1;
+    const auto status = ParseStatus(name);
+    // ParseStatus ignores case and maps unrecognized names to kUnknown, so only a spelled-out
+    // "unknown" (in any case) may select it.
+    if (status == ChecklistStatus::kUnknown && UpperCase(name) != "UNKNOWN") {
+      throw std::invalid_argument("Status must be Pass, Fail, NA, Other, or Unknown.");
+    }
+    query.statuses.push_back(status);
+  }
+  const std::string limit = GetQueryParam(request, "limit", "");
+  if (!limit.empty()) {
+    try {
+      query.limit = std::stoul(limit);
+    } catch (const std::exception&) {
+      query.limit = 0;
+    }
+    if (query.limit == 0 || query.limit > kMaxPageLimit) {
+      throw std::invalid_argument("Query parameter 'limit' must be between 1 and " +
+                                  std::to_string(kMaxPageLimit) + ".");
+    }
   }
+  query.after = GetQueryParam(request, "cursor", "");
+  return query;
+}
 
-  return {{"address_id", slug.address_id},
-          {"checklist", slug.checklist},
-          {"section", slug.section},
-          {"procedure", slug.procedure},
-          {"action", slug.action},
-          {"spec", slug.spec},
-          {"result", slug.result},
-          {"status", StatusToString(slug.status)},
-          {"comment", slug.comment},
-          {"timestamp", slug.timestamp},
-          {"instructions", slug.instructions},
-          {"relationships", relationships}};
+int64_t ToMicros(std::chrono::nanoseconds value) {
+  return std::chrono::duration_cast<std::chrono::microseconds>(value).count();
 }
 
-SlugUpdate ParseUpdatePayload(const json& payload) {
-  if (!payload.is_object()) {
-    throw std::invalid_argument("Payload must be a JSON object.");
+json LockProfileToJson(const LockProfile& profile) {
+  json sites = json::array();
+  for (const auto& site : profile.sites) {
+    const auto count = static_cast<int64_t>(site.acquisitions);
+    sites.push_back({{"site", site.site},
+                     {"acquisitions", site.acquisitions},
+                     {"wait_us_total", ToMicros(site.total_wait)},
+                     {"wait_us_avg", count > 0 ? ToMicros(site.total_wait) / count : 0},
+                     {"wait_us_max", ToMicros(site.max_wait)},
+                     {"hold_us_total", ToMicros(site.total_hold)},
+                     {"hold_us_avg", count > 0 ? ToMicros(site.total_hold) / count : 0},
+                     {"hold_us_max", ToMicros(site.max_hold)}});
   }
-  const auto it = payload.find("address_id");
-  if (it == payload.end() || !it->is_string()) {
-    throw std::invalid_argument("Field 'address_id' is required and must be a string.");
+  json holders = json::array();
+  for (const auto& sample : profile.longest_holders) {
+    const auto released_ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+                                 sample.released_at.time_since_epoch())
+                                 .count();
+    holders.push_back({{"site", sample.site},
+                       {"wait_us", ToMicros(sample.wait)},
+                       {"hold_us", ToMicros(sample.hold)},
+                       {"released_at_unix_ms", released_ms}});
   }
+  return {{"sites", sites}, {"longest_holders", holders}};
+}
 
-  SlugUpdate update;
-  update.address_id = it->get<std::string>();
-
-  if (const auto result_it = payload.find("result"); result_it != payload.end() &&
-                                                     (result_it->is_string() || result_it->is_null())) {
-    update.result = result_it->is_null() ? std::string{} : result_it->get<std::string>();
+json WalCheckpointStatsToJson(const std::optional<WalCheckpointStats>& stats) {
+  if (!stats) {
+    return nullptr;
   }
+  const auto runs = static_cast<int64_t>(stats->passive_runs + stats->truncate_runs);
+  return {{"commits_observed", stats->commits_observed},
+          {"passive_runs", stats->passive_runs},
+          {"truncate_runs", stats->truncate_runs},
+          {"busy_runs", stats->busy_runs},
+          {"duration_us_last", stats->last_duration.count()},
+          {"duration_us_avg", runs > 0 ? stats->total_duration.count() / runs : 0},
+          {"duration_us_max", stats->max_duration.count()},
+          {"wal_frames", stats->last_wal_frames},
+          {"checkpointed_frames", stats->last_checkpointed_frames},
+          {"wal_bytes", stats->wal_bytes}};
+}
 
-  if (const auto status_it = payload.find("status"); status_it != payload.end()) {
-    if (!status_it->is_string()) {
-      throw std::invalid_argument("Field 'status' must be a string when provided.");
-    }
-    const auto status = ParseStatus(status_it->get<std::string>());
-    if (status == ChecklistStatus::kUnknown) {
-      throw std::invalid_argument("Status must be Pass, Fail, NA, or Other.");
-    }
-    update.status = status;
+json SlugCacheStatsToJson(const SlugCacheStats& stats) {
+  return {{"enabled", stats.enabled},
+          {"complete", stats.complete},
+          {"checklists", stats.checklists},
+          {"slugs", stats.slugs},
+          {"relationships", stats.relationships},
+          {"interned_strings", stats.interned_strings},
+          {"approx_bytes", stats.approx_bytes},
+          {"hits", stats.hits},
+          {"misses", stats.misses}};
+}
+
+json SingleFlightStatsToJson(const SingleFlightStats& stats) {
+  return {{"computations", stats.computations},
+          {"coalesced", stats.coalesced},
+          {"in_flight", stats.in_flight}};
+}
+
+json AdmissionStatsToJson(const platform::AdmissionStats& stats) {
+  json classes = json::object();
+  for (const auto& [route_class, name] : {std::pair{platform::RouteClass::kRead, "read"},
+                                          std::pair{platform::RouteClass::kWrite, "write"},
+                                          std::pair{platform::RouteClass::kHeavy, "heavy"}}) {
+    const auto index = static_cast<std::size_t>(route_class);
+    classes[name] = {{"admitted", stats.admitted[index]},
+                     {"rate_limited", stats.rate_limited[index]}};
   }
+  return {{"classes", classes},
+          {"concurrency_limited", stats.concurrency_limited},
+          {"heavy_in_flight", stats.heavy_in_flight}};
+}
 
-  if (const auto comment_it = payload.find("comment");
-      comment_it != payload.end() && (comment_it->is_string() || comment_it->is_null())) {
-    update.comment = comment_it->is_null() ? std::string{} : comment_it->get<std::string>();
+// The store-side view of a socket request's deadline and client liveness.
+Cancellation RequestCancellation(const platform::HttpRequest& request) {
+  return {request.deadline, request.client_gone};
+}
+
+// 499 is nginx's "client closed request"; it only shows up in logs since nobody is left to read it.
+platform::HttpResponse CancelledResponse(const OperationCancelled& ex) {
+  LogWarn(std::string{"Request cancelled: "} + ex.what());
+  return ErrorResponse(ex.what(), ex.deadline_exceeded() ? 504 : 499);
+}
+
+// Identifies a GET for coalescing: the path plus its query parameters, which arrive sorted.
+std::string ReadKey(const platform::HttpRequest& request) {
+  std::string key = request.path;
+  for (const auto& [name, value] : request.query_params) {
+    key.append(1, '\0').append(name).append(1, '=').append(value);
   }
+  return key;
+}
 
-  if (const auto ts_it = payload.find("timestamp"); ts_it != payload.end()) {
-    if (!ts_it->is_string()) {
-      throw std::invalid_argument("Field 'timestamp' must be a string when provided.");
-    }
-    update.timestamp = ts_it->get<std::string>();
+json JsonlImportReportToJson(const JsonlImportReport& report) {
+  json errors = json::array();
+  for (const auto& error : report.errors) {
+    errors.push_back({{"line", error.line}, {"error", error.error}});
   }
+  return {{"lines", report.lines},
+          {"imported", report.imported},
+          {"failed", report.failed},
+          {"batches", report.batches},
+          {"relationships_deferred", report.relationships_deferred},
+          {"relationships_unresolved", report.relationships_unresolved},
+          {"errors", errors},
+          {"errors_truncated", report.errors_truncated}};
+}
 
-  return update;
+json StorageSettingsToJson(const StorageSettings& settings) {
+  return {{"profile", settings.profile},
+          {"synchronous", settings.synchronous},
+          {"cache_size_kib", settings.cache_size_kib},
+          {"mmap_size_bytes", settings.mmap_size_bytes},
+          {"temp_store", settings.temp_store},
+          {"wal_autocheckpoint_pages", settings.wal_autocheckpoint_pages},
+          {"busy_timeout_ms", settings.busy_timeout_ms}};
 }
 
-std::vector<SlugUpdate> ParseBulkPayload(const json& payload) {
-  if (!payload.is_array()) {
-    throw std::invalid_argument("Bulk payload must be a JSON array.");
+int ReadIntEnv(const char* name, int fallback, int minimum, int maximum) {
+  const char* raw = std::getenv(name);
+  if (!raw) {
+    return fallback;
   }
-  std::vector<SlugUpdate> updates;
-  for (const auto& item : payload) {
-    updates.push_back(ParseUpdatePayload(item));
+  try {
+    const int parsed = std::stoi(raw);
+    if (parsed >= minimum && parsed <= maximum) {
+      return parsed;
+    }
+    LogWarn(std::string{name} + " is outside [" + std::to_string(minimum) + ", " +
+            std::to_string(maximum) + "], falling back to " + std::to_string(fallback));
+  } catch (const std::exception& ex) {
+    LogWarn(std::string{"Failed to parse "} + name + ": " + ex.what());
   }
-  return updates;
+  return fallback;
 }
 
 platform::HttpResponse HandleCorsPreflight(const platform::HttpRequest&) {
@@ -182,7 +327,37 @@ platform::HttpResponse HandleCorsPreflight(const platform::HttpRequest&) {
 
 }  // namespace
 
-void ConfigureServer(platform::HttpServer& server, ChecklistStore& store) {
+void ConfigureServer(platform::HttpServer& server, ChecklistStore& store,
+                     const ServerConfig& config) {
+  constexpr auto kHeavy = platform::RouteClass::kHeavy;
+  // Identical GETs that arrive while one is being computed (e.g. every open portal tab
+  // refreshing after an update) share its response instead of each re-running the read.
+  const auto flights = std::make_shared<SingleFlight>();
+  // Turns a cancelled store read, or a wait on another request's read, into its 504/499
+  // response. Wraps the coalescing layer, so a request that gives up never hands its
+  // cancellation to the requests waiting on it.
+  const auto cancellable = [](platform::HttpHandler handler) {
+    return platform::HttpHandler{
+        [handler = std::move(handler)](const platform::HttpRequest& request) {
+          try {
+            return handler(request);
+          } catch (const OperationCancelled& ex) {
+            return CancelledResponse(ex);
+          }
+        }};
+  };
+  const auto coalesced = [flights, &store,
+                          enabled = config.single_flight](platform::HttpHandler handler) {
+    if (!enabled) {
+      return handler;
+    }
+    return platform::HttpHandler{
+        [flights, &store, handler = std::move(handler)](const platform::HttpRequest& request) {
+          return flights->Do(ReadKey(request), store.WriteGeneration(),
+                             [&] { return handler(request); }, RequestCancellation(request));
+        }};
+  };
+
   auto handle_commands = [](const platform::HttpRequest&) {
     json commands = json::array();
     for (const auto& cmd : kCommandCatalog) {
@@ -197,14 +372,43 @@ void ConfigureServer(platform::HttpServer& server, ChecklistStore& store) {
     const auto now = std::chrono::steady_clock::now();
     const auto uptime_ms =
         std::chrono::duration_cast<std::chrono::milliseconds>(now - kServerStart).count();
+    StartupReport startup;
+    {
+      std::lock_guard<std::mutex> lock(startup_mutex);
+      startup = startup_report;
+    }
     json payload{{"status", "ok"},
                  {"uptime_ms", uptime_ms},
                  {"version", "0.2.0"},
-                 {"checklists", store.ListChecklists()}};
+                 {"checklists", store.ListChecklists()},
+                 {"startup",
+                  {{"restored_from", startup.restored_from},
+                   {"restore_ms", startup.restore_ms},
+                   {"open_ms", startup.open_ms},
+                   {"warmup_ms", startup.warmup_ms},
+                   {"warmup_bytes", startup.warmup_bytes},
+                   {"warmup_rows", startup.warmup_rows},
+                   {"warmup_complete", startup.warmup_complete},
+                   {"ready_ms", startup.ready_ms}}},
+                 {"storage", StorageSettingsToJson(store.EffectiveStorageSettings())}};
     LogInfo("GET /api/health");
     return JsonResponse(payload);
   };
 
+  auto handle_metrics = [&store, &server, flights](const platform::HttpRequest&) {
+    const auto now = std::chrono::steady_clock::now();
+    const auto uptime_ms =
+        std::chrono::duration_cast<std::chrono::milliseconds>(now - kServerStart).count();
+    json payload{{"uptime_ms", uptime_ms},
+                 {"store_lock", LockProfileToJson(store.LockContention())},
+                 {"wal_checkpoint", WalCheckpointStatsToJson(store.WalCheckpointerStats())},
+                 {"slug_cache", SlugCacheStatsToJson(store.CachedSlugStats())},
+                 {"single_flight", SingleFlightStatsToJson(flights->Stats())},
+                 {"admission", AdmissionStatsToJson(server.Admission())}};
+    LogInfo("GET /api/metrics");
+    return JsonResponse(payload);
+  };
+
   auto handle_hello = [](const platform::HttpRequest& request) {
     const std::string name = GetQueryParam(request, "name", "world");
     LogInfo("GET /api/hello name=" + name);
@@ -233,13 +437,78 @@ void ConfigureServer(platform::HttpServer& server, ChecklistStore& store) {
     return JsonResponse(SlugToJson(slug));
   };
 
+  auto handle_slugs = [&store](const platform::HttpRequest& request) {
+    const auto payload = json::parse(request.body, nullptr, false);
+    if (payload.is_discarded() || !payload.is_object()) {
+      return ErrorResponse("Payload must be a JSON object.", 400);
+    }
+    const auto ids_it = payload.find("address_ids");
+    if (ids_it == payload.end() || !ids_it->is_array()) {
+      return ErrorResponse("Field 'address_ids' is required and must be an array.", 400);
+    }
+    if (ids_it->size() > kMaxBatchSlugs) {
+      return ErrorResponse("At most " + std::to_string(kMaxBatchSlugs) +
+                               " address_ids per request.",
+                           400);
+    }
+    std::vector<std::string> address_ids;
+    address_ids.reserve(ids_it->size());
+    std::uint32_t fields = kAllSlugFields;
+    try {
+      for (const auto& id : *ids_it) {
+        if (!id.is_string()) {
+          throw std::invalid_argument("Entries in 'address_ids' must be strings.");
+        }
+        address_ids.push_back(id.get<std::string>());
+      }
+      if (const auto fields_it = payload.find("fields"); fields_it != payload.end()) {
+        if (!fields_it->is_string()) {
+          throw std::invalid_argument("Field 'fields' must be a comma-separated string.");
+        }
+        fields = ParseSlugFields(fields_it->get<std::string>());
+      }
+    } catch (const std::invalid_argument& ex) {
+      return ErrorResponse(ex.what(), 400);
+    }
+    LogInfo("POST /api/slugs count=" + std::to_string(address_ids.size()));
+    const auto slugs = store.GetSlugs(address_ids);
+    json found = json::array();
+    json missing = json::array();
+    for (std::size_t i = 0; i < slugs.size(); ++i) {
+      if (slugs[i]) {
+        found.push_back(SlugToJson(*slugs[i], fields));
+      } else {
+        missing.push_back(address_ids[i]);
+      }
+    }
+    return JsonResponse(json{{"slugs", found}, {"missing", missing}});
+  };
+
   auto handle_checklist = [&store](const platform::HttpRequest& request) {
     if (request.path_params.empty()) {
       return ErrorResponse("Missing checklist path parameter.", 400);
     }
     const std::string checklist = request.path_params.front();
     LogInfo("GET /api/checklist/" + checklist);
-    const auto slugs = store.GetSlugsForChecklist(checklist);
+    if (HasSlugQueryParams(request)) {
+      try {
+        auto query = ParseSlugQuery(request);
+        query.checklist = checklist;
+        const auto page = store.QuerySlugs(query, RequestCancellation(request));
+        json payload = json::array();
+        for (const auto& slug : page.slugs) {
+          payload.push_back(SlugToJson(slug, query.fields));
+        }
+        return JsonResponse(json{{"checklist", checklist},
+                                 {"slugs", payload},
+                                 {"next_cursor", page.next_cursor.empty()
+                                                     ? json(nullptr)
+                                                     : json(page.next_cursor)}});
+      } catch (const std::invalid_argument& ex) {
+        return ErrorResponse(ex.what(), 400);
+      }
+    }
+    const auto slugs = store.GetSlugsForChecklist(checklist, RequestCancellation(request));
     json payload = json::array();
     for (const auto& slug : slugs) {
       payload.push_back(SlugToJson(slug));
@@ -259,6 +528,129 @@ void ConfigureServer(platform::HttpServer& server, ChecklistStore& store) {
     return JsonResponse(payload);
   };
 
+  auto handle_summary = [&store](const platform::HttpRequest& request) {
+    const std::string level_name = GetQueryParam(request, "level", "checklist");
+    RollupLevel level = RollupLevel::kChecklist;
+    if (level_name == "section") {
+      level = RollupLevel::kSection;
+    } else if (level_name == "procedure") {
+      level = RollupLevel::kProcedure;
+    } else if (level_name != "checklist") {
+      return ErrorResponse("Query parameter 'level' must be checklist, section, or procedure.",
+                           400);
+    }
+    const std::string checklist = GetQueryParam(request, "checklist", "");
+    LogInfo("GET /api/summary level=" + level_name);
+
+    json nodes = json::array();
+    for (const auto& rollup : store.GetStatusRollup(level, checklist)) {
+      json counts = json::object();
+      for (const auto status : {ChecklistStatus::kPass, ChecklistStatus::kFail,
+                                ChecklistStatus::kNA, ChecklistStatus::kOther,
+                                ChecklistStatus::kUnknown}) {
+        counts[StatusToString(status)] = rollup.Count(status);
+      }
+      json node = {{"checklist", rollup.checklist}, {"counts", counts}, {"total", rollup.Total()}};
+      if (level != RollupLevel::kChecklist) {
+        node["section"] = rollup.section;
+      }
+      if (level == RollupLevel::kProcedure) {
+        node["procedure"] = rollup.procedure;
+      }
+      nodes.push_back(std::move(node));
+    }
+    return JsonResponse(json{{"level", level_name}, {"nodes", nodes}});
+  };
+
+  auto handle_search = [&store](const platform::HttpRequest& request) {
+    SearchQuery query;
+    query.text = GetQueryParam(request, "q", "");
+    const std::string checklists = GetQueryParam(request, "checklist", "");
+    std::size_t start = 0;
+    while (start < checklists.size()) {
+      const auto end = std::min(checklists.find(',', start), checklists.size());
+      if (end > start) {
+        query.checklists.push_back(checklists.substr(start, end - start));
+      }
+      start = end + 1;
+    }
+    const std::string limit = GetQueryParam(request, "limit", "");
+    if (!limit.empty()) {
+      try {
+        query.limit = std::stoul(limit);
+      } catch (const std::exception&) {
+        query.limit = 0;
+      }
+      if (query.limit == 0 || query.limit > kMaxSearchLimit) {
+        return ErrorResponse("Query parameter 'limit' must be between 1 and " +
+                                 std::to_string(kMaxSearchLimit) + ".",
+                             400);
+      }
+    }
+    LogInfo("GET /api/search q=" + query.text);
+
+    std::vector<SearchHit> hits;
+    try {
+      hits = store.Search(query);
+    } catch (const std::invalid_argument& ex) {
+      return ErrorResponse(ex.what(), 400);
+    }
+    constexpr std::uint32_t kHitFields = kSlugFieldChecklist | kSlugFieldSection |
+                                         kSlugFieldProcedure | kSlugFieldAction |
+                                         kSlugFieldSpec | kSlugFieldStatus;
+    json results = json::array();
+    for (const auto& hit : hits) {
+      json item = SlugToJson(hit.slug, kHitFields);
+      item["score"] = hit.score;
+      item["snippet"] = hit.snippet;
+      results.push_back(std::move(item));
+    }
+    return JsonResponse(json{{"query", query.text}, {"results", results}});
+  };
+
+  auto handle_history = [&store](const platform::HttpRequest& request) {
+    if (request.path_params.empty()) {
+      return ErrorResponse("Missing address_id path parameter.", 400);
+    }
+    const std::string address_id = request.path_params.front();
+    HistoryRange range;
+    range.from = GetQueryParam(request, "from", "");
+    range.to = GetQueryParam(request, "to", "");
+    const std::string limit_param = GetQueryParam(request, "limit", "");
+    if (!limit_param.empty()) {
+      try {
+        range.limit = std::stoul(limit_param);
+      } catch (const std::exception&) {
+        range.limit = 0;
+      }
+      if (range.limit == 0 || range.limit > kMaxHistoryLimit) {
+        return ErrorResponse("Query parameter 'limit' must be between 1 and " +
+                                 std::to_string(kMaxHistoryLimit) + ".",
+                             400);
+      }
+    }
+    LogInfo("GET /api/history/" + address_id);
+
+    // One extra row tells whether another page exists without a second query.
+    const std::size_t page = range.limit;
+    ++range.limit;
+    auto entries = store.GetHistory(address_id, range);
+    const bool more = entries.size() > page;
+    entries.resize(std::min(entries.size(), page));
+
+    json items = json::array();
+    for (const auto& entry : entries) {
+      items.push_back({{"timestamp", entry.timestamp},
+                       {"result", entry.result},
+                       {"status", StatusToString(entry.status)},
+                       {"comment", entry.comment}});
+    }
+    // Pass `next_to` back as `to` for the next (older) page.
+    return JsonResponse(json{{"address_id", address_id},
+                             {"entries", items},
+                             {"next_to", more ? json(entries.back().timestamp) : json(nullptr)}});
+  };
+
   auto handle_update = [&store](const platform::HttpRequest& request) {
     const auto payload = json::parse(request.body, nullptr, false);
     if (payload.is_discarded()) {
@@ -282,39 +674,84 @@ void ConfigureServer(platform::HttpServer& server, ChecklistStore& store) {
     }
     try {
       const auto updates = ParseBulkPayload(payload);
-      store.ApplyBulkUpdates(updates);
-      json updated = json::array();
+      store.ApplyBulkUpdates(updates, RequestCancellation(request));
+      std::vector<std::string> address_ids;
+      address_ids.reserve(updates.size());
       for (const auto& update : updates) {
-        updated.push_back(SlugToJson(store.GetSlugOrThrow(update.address_id)));
+        address_ids.push_back(update.address_id);
+      }
+      json updated = json::array();
+      for (const auto& slug : store.GetSlugs(address_ids)) {
+        if (slug) {
+          updated.push_back(SlugToJson(*slug));
+        }
       }
       LogInfo("PATCH /api/update_bulk count=" + std::to_string(updates.size()));
       return JsonResponse(json{{"updated", updated}});
+    } catch (const OperationCancelled& ex) {
+      return CancelledResponse(ex);
     } catch (const std::exception& ex) {
       return ErrorResponse(ex.what(), 400);
     }
   };
 
-  auto handle_export_json = [&store](const platform::HttpRequest&) {
-    const auto slugs = store.ExportAllSlugs();
+  // Unfiltered exports come from the slug cache; filtered or paged ones are pushed into SQL and
+  // return the next page's cursor in X-Next-Cursor so the body keeps its array/JSONL shape.
+  auto export_page = [&store](const platform::HttpRequest& request, SlugQuery& query) {
+    if (!HasSlugQueryParams(request)) {
+      return SlugPage{store.ExportAllSlugs(RequestCancellation(request)), {}};
+    }
+    query = ParseSlugQuery(request);
+    return store.QuerySlugs(query, RequestCancellation(request));
+  };
+
+  auto handle_export_json = [export_page](const platform::HttpRequest& request) {
+    SlugQuery query;
+    SlugPage page;
+    try {
+      page = export_page(request, query);
+    } catch (const std::invalid_argument& ex) {
+      return ErrorResponse(ex.what(), 400);
+    }
+    // Serializing a full export is most of its cost, so an abandoned one stops here too.
+    const auto cancel = RequestCancellation(request);
     json payload = json::array();
-    for (const auto& slug : slugs) {
-      payload.push_back(SlugToJson(slug));
+    for (std::size_t i = 0; i < page.slugs.size(); ++i) {
+      cancel.ThrowIfCancelled(i);
+      payload.push_back(SlugToJson(page.slugs[i], query.fields));
     }
     LogInfo("GET /api/export/json");
-    return JsonResponse(payload);
+    auto response = JsonResponse(payload);
+    if (!page.next_cursor.empty()) {
+      response.headers["X-Next-Cursor"] = page.next_cursor;
+    }
+    return response;
   };
 
-  auto handle_export_jsonl = [&store](const platform::HttpRequest&) {
-    const auto slugs = store.ExportAllSlugs();
+  auto handle_export_jsonl = [export_page](const platform::HttpRequest& request) {
+    SlugQuery query;
+    SlugPage page;
+    try {
+      page = export_page(request, query);
+    } catch (const std::invalid_argument& ex) {
+      return ErrorResponse(ex.what(), 400);
+    }
+    const auto& slugs = page.slugs;
+    const auto cancel = RequestCancellation(request);
     std::ostringstream stream;
     for (std::size_t i = 0; i < slugs.size(); ++i) {
-      stream << SlugToJson(slugs[i]).dump();
+      cancel.ThrowIfCancelled(i);
+      stream << SlugToJson(slugs[i], query.fields).dump();
       if (i + 1 < slugs.size()) {
         stream << "\n";
       }
     }
     LogInfo("GET /api/export/jsonl");
-    return TextResponse(stream.str(), "application/json", 200);
+    auto response = TextResponse(stream.str(), "application/json", 200);
+    if (!page.next_cursor.empty()) {
+      response.headers["X-Next-Cursor"] = page.next_cursor;
+    }
+    return response;
   };
 
   auto handle_export_markdown = [&store](const platform::HttpRequest& request) {
@@ -323,7 +760,7 @@ void ConfigureServer(platform::HttpServer& server, ChecklistStore& store) {
     }
     const std::string checklist = request.path_params.front();
     LogInfo("GET /api/export/markdown/" + checklist);
-    const auto slugs = store.GetSlugsForChecklist(checklist);
+    const auto slugs = store.GetSlugsForChecklist(checklist, RequestCancellation(request));
     if (slugs.empty()) {
       return ErrorResponse("Checklist not found: " + checklist, 404);
     }
@@ -345,47 +782,242 @@ void ConfigureServer(platform::HttpServer& server, ChecklistStore& store) {
     }
     try {
       const auto parsed = core::markdown::ParseChecklistMarkdown(checklist, request.body);
-      store.ReplaceChecklist(checklist, parsed.slugs);
+      store.ReplaceChecklist(checklist, parsed.slugs, RequestCancellation(request));
       LogInfo("POST /api/import/markdown checklist=" + checklist);
       return JsonResponse(json{{"checklist", checklist}, {"imported", parsed.slugs.size()}});
+    } catch (const OperationCancelled& ex) {
+      return CancelledResponse(ex);
+    } catch (const std::exception& ex) {
+      return ErrorResponse(ex.what(), 400);
+    }
+  };
+
+  auto handle_import_jsonl = [&store](const platform::HttpRequest& request,
+                                      const platform::HttpBodyReader& read_body) {
+    std::size_t batch_size = JsonlImporter::kDefaultBatchSize;
+    const std::string batch_param = GetQueryParam(request, "batch_size", "");
+    if (!batch_param.empty()) {
+      try {
+        batch_size = std::stoul(batch_param);
+      } catch (const std::exception&) {
+        return ErrorResponse("Query parameter 'batch_size' must be a positive integer.", 400);
+      }
+      if (batch_size == 0 || batch_size > JsonlImporter::kMaxBatchSize) {
+        return ErrorResponse("Query parameter 'batch_size' must be between 1 and " +
+                                 std::to_string(JsonlImporter::kMaxBatchSize) + ".",
+                             400);
+      }
+    }
+
+    // Batches already committed stay committed if the store fails mid-stream; the report says
+    // how far the import got so the caller can re-send (upserts make that idempotent).
+    JsonlImporter importer(store, batch_size, RequestCancellation(request));
+    std::string store_error;
+    std::optional<OperationCancelled> cancelled;
+    const bool complete = read_body([&](const char* data, std::size_t length) {
+      try {
+        importer.Feed(std::string_view(data, length));
+        return true;
+      } catch (const OperationCancelled& ex) {
+        cancelled = ex;
+        return false;
+      } catch (const std::exception& ex) {
+        store_error = ex.what();
+        return false;
+      }
+    });
+    if (cancelled) {
+      return CancelledResponse(*cancelled);
+    }
+
+    JsonlImportReport report;
+    try {
+      report = importer.Finish();
+    } catch (const std::exception& ex) {
+      if (store_error.empty()) {
+        store_error = ex.what();
+      }
+    }
+
+    json payload = JsonlImportReportToJson(report);
+    payload["complete"] = complete && store_error.empty();
+    LogInfo("POST /api/import/jsonl imported=" + std::to_string(report.imported) +
+            " failed=" + std::to_string(report.failed) +
+            " batches=" + std::to_string(report.batches));
+    if (!store_error.empty()) {
+      LogWarn("POST /api/import/jsonl aborted: " + store_error);
+      payload["error"] = store_error;
+      return JsonResponse(payload, 500);
+    }
+    return JsonResponse(payload);
+  };
+
+  SnapshotOptions snapshot_options;
+  snapshot_options.pages_per_step = config.snapshot_pages_per_step;
+  snapshot_options.step_pause = std::chrono::milliseconds(config.snapshot_step_pause_ms);
+  auto handle_snapshot = [&store, directory = config.snapshot_directory,
+                          snapshot_options](const platform::HttpRequest& request) {
+    std::string path;
+    try {
+      path = ResolveSnapshotPath(directory,
+                                 GetQueryParam(request, "name", DefaultSnapshotName()));
     } catch (const std::exception& ex) {
       return ErrorResponse(ex.what(), 400);
     }
+    try {
+      const auto result = store.Snapshot(path, snapshot_options);
+      LogInfo("POST /api/snapshot path=" + result.path);
+      return JsonResponse(json{{"path", result.path},
+                               {"pages", result.pages},
+                               {"bytes", result.bytes},
+                               {"steps", result.steps},
+                               {"duration_ms", result.duration.count()}});
+    } catch (const SnapshotBusyError& ex) {
+      return ErrorResponse(ex.what(), 409);
+    }
+  };
+
+  // MCP over HTTP: the same tool catalog as apim-mcp-bridge, but each tool's request is handed
+  // to the matching handler above through Dispatch instead of a loopback connection. The bridge
+  // is built per /mcp request so every tool call is admitted under its own route's class (an
+  // export is heavy) on behalf of the /mcp caller, and stops at that caller's deadline or
+  // disconnect. /mcp itself is kUncharged, so each tool call is charged exactly once.
+  auto mcp_tools_for = [&server](const platform::HttpRequest& outer) {
+    return mcp::Bridge([&server, &outer](const mcp::ToolRequest& tool) {
+      platform::HttpRequest request;
+      request.path = tool.path;
+      request.body = tool.body;
+      request.query_params = tool.query;
+      request.client = outer.client;
+      request.deadline = outer.deadline;
+      request.client_gone = outer.client_gone;
+      if (!tool.content_type.empty()) {
+        request.headers["Content-Type"] = tool.content_type;
+      }
+      const auto method = tool.method == "GET"    ? platform::HttpMethod::kGet
+                          : tool.method == "POST" ? platform::HttpMethod::kPost
+                                                  : platform::HttpMethod::kPatch;
+      auto response = server.Dispatch(method, std::move(request), /*admit=*/true);
+      return platform::HttpClientResponse{response.status, std::move(response.content_type),
+                                          std::move(response.body), std::move(response.headers)};
+    });
+  };
+  const mcp::DisplayOptions mcp_display{
+      /*compact=*/true, static_cast<std::size_t>(config.mcp_max_result_bytes)};
+  auto handle_rpc = [mcp_display](const mcp::Bridge& mcp_tools, const json& message) -> json {
+    if (!message.is_object()) {
+      return mcp::MakeErrorPayload(nullptr, -32600, "Invalid request.");
+    }
+    const auto method = message.value("method", std::string{});
+    const auto id_it = message.find("id");
+    if (id_it == message.end()) {
+      return nullptr;  // notification
+    }
+    const json& id = *id_it;
+    if (method == "initialize") {
+      return mcp::MakeResultPayload(
+          id, {{"serverInfo", {{"name", "apim-cpp-server"}, {"version", "0.2.0"}}},
+               {"capabilities", {{"tools", {{"listChanged", false}}}}}});
+    }
+    if (method == "tools/list") {
+      return mcp::MakeResultPayload(id, {{"tools", mcp_tools.ToolSchemasJson()}});
+    }
+    if (method == "tools/call") {
+      try {
+        return mcp::MakeResultPayload(
+            id, mcp_tools.CallToolContent(message.at("params"), mcp_display));
+      } catch (const std::exception& ex) {
+        return mcp::MakeErrorPayload(id, -32000, ex.what());
+      }
+    }
+    if (method == "ping" || method == "shutdown") {
+      return mcp::MakeResultPayload(id, json::object());
+    }
+    return mcp::MakeErrorPayload(id, -32601, "Unsupported method: " + method);
+  };
+
+  // Accepts a single JSON-RPC message or a batch array; notifications alone get 202 and no body.
+  auto handle_mcp = [handle_rpc, mcp_tools_for](const platform::HttpRequest& request) {
+    const auto message = json::parse(request.body, nullptr, false);
+    if (message.is_discarded()) {
+      return JsonResponse(mcp::MakeErrorPayload(nullptr, -32700, "Parse error."), 400);
+    }
+    const auto mcp_tools = mcp_tools_for(request);
+    json reply = nullptr;
+    if (message.is_array()) {
+      reply = json::array();
+      for (const auto& item : message) {
+        if (auto response = handle_rpc(mcp_tools, item); !response.is_null()) {
+          reply.push_back(std::move(response));
+        }
+      }
+      if (reply.empty()) {
+        reply = nullptr;
+      }
+    } else {
+      reply = handle_rpc(mcp_tools, message);
+    }
+    if (reply.is_null()) {
+      return TextResponse("", "text/plain", 202);
+    }
+    return JsonResponse(reply);
   };
 
   server.AddHandler(platform::HttpMethod::kGet, "/api/commands", handle_commands);
   server.AddHandler(platform::HttpMethod::kGet, "/api/health", handle_health);
+  server.AddHandler(platform::HttpMethod::kGet, "/api/metrics", handle_metrics);
   server.AddHandler(platform::HttpMethod::kGet, "/api/hello", handle_hello);
   server.AddHandler(platform::HttpMethod::kPost, "/api/echo", handle_echo);
   server.AddHandler(platform::HttpMethod::kGet, "/api/checklists", handle_checklists);
   server.AddHandler(platform::HttpMethod::kGet, R"(/api/slug/(.+))", handle_slug);
-  server.AddHandler(platform::HttpMethod::kGet, R"(/api/checklist/(.+))", handle_checklist);
+  server.AddHandler(platform::HttpMethod::kPost, "/api/slugs", handle_slugs);
+  server.AddHandler(platform::HttpMethod::kGet, R"(/api/checklist/(.+))",
+                    cancellable(coalesced(handle_checklist)));
   server.AddHandler(platform::HttpMethod::kGet, R"(/api/relationships/(.+))",
                     handle_relationships);
+  server.AddHandler(platform::HttpMethod::kGet, R"(/api/history/(.+))", handle_history);
+  server.AddHandler(platform::HttpMethod::kGet, "/api/search",
+                    cancellable(coalesced(handle_search)));
+  server.AddHandler(platform::HttpMethod::kGet, "/api/summary",
+                    cancellable(coalesced(handle_summary)));
   server.AddHandler(platform::HttpMethod::kPatch, "/api/update", handle_update);
   server.AddHandler(platform::HttpMethod::kPatch, "/api/update_bulk", handle_update_bulk);
-  server.AddHandler(platform::HttpMethod::kGet, "/api/export/json", handle_export_json);
-  server.AddHandler(platform::HttpMethod::kGet, "/api/export/jsonl", handle_export_jsonl);
+  server.AddHandler(platform::HttpMethod::kGet, "/api/export/json",
+                    cancellable(coalesced(handle_export_json)), kHeavy);
+  server.AddHandler(platform::HttpMethod::kGet, "/api/export/jsonl",
+                    cancellable(coalesced(handle_export_jsonl)), kHeavy);
   server.AddHandler(platform::HttpMethod::kGet, R"(/api/export/markdown/(.+))",
-                    handle_export_markdown);
-  server.AddHandler(platform::HttpMethod::kPost, "/api/import/markdown", handle_import_markdown);
-
-  server.AddHandler(platform::HttpMethod::kOptions, "/api/commands", HandleCorsPreflight);
-  server.AddHandler(platform::HttpMethod::kOptions, "/api/health", HandleCorsPreflight);
-  server.AddHandler(platform::HttpMethod::kOptions, "/api/hello", HandleCorsPreflight);
-  server.AddHandler(platform::HttpMethod::kOptions, "/api/echo", HandleCorsPreflight);
-  server.AddHandler(platform::HttpMethod::kOptions, "/api/checklists", HandleCorsPreflight);
-  server.AddHandler(platform::HttpMethod::kOptions, R"(/api/slug/.*)", HandleCorsPreflight);
-  server.AddHandler(platform::HttpMethod::kOptions, R"(/api/checklist/.*)", HandleCorsPreflight);
-  server.AddHandler(platform::HttpMethod::kOptions, R"(/api/relationships/.*)",
-                    HandleCorsPreflight);
-  server.AddHandler(platform::HttpMethod::kOptions, "/api/update", HandleCorsPreflight);
-  server.AddHandler(platform::HttpMethod::kOptions, "/api/update_bulk", HandleCorsPreflight);
-  server.AddHandler(platform::HttpMethod::kOptions, "/api/export/json", HandleCorsPreflight);
-  server.AddHandler(platform::HttpMethod::kOptions, "/api/export/jsonl", HandleCorsPreflight);
-  server.AddHandler(platform::HttpMethod::kOptions, R"(/api/export/markdown/.*)",
-                    HandleCorsPreflight);
-  server.AddHandler(platform::HttpMethod::kOptions, "/api/import/markdown", HandleCorsPreflight);
+                    cancellable(coalesced(handle_export_markdown)), kHeavy);
+  server.AddHandler(platform::HttpMethod::kPost, "/api/import/markdown", handle_import_markdown,
+                    kHeavy);
+  server.AddStreamingHandler(platform::HttpMethod::kPost, "/api/import/jsonl", handle_import_jsonl,
+                             kHeavy);
+  server.AddHandler(platform::HttpMethod::kPost, "/api/snapshot", handle_snapshot, kHeavy);
+  server.AddHandler(platform::HttpMethod::kPost, "/mcp", handle_mcp,
+                    platform::RouteClass::kUncharged);
+
+  server.SetPreflightHandler(HandleCorsPreflight);
+
+  // Buckets hold `rate_burst_seconds` worth of requests, so a quiet client can burst briefly.
+  const auto rate_limit = [&config](int per_second) {
+    return platform::RateLimit{static_cast<double>(per_second),
+                               static_cast<double>(per_second) * config.rate_burst_seconds};
+  };
+  platform::AdmissionPolicy admission;
+  admission.read = rate_limit(config.rate_read_per_second);
+  admission.write = rate_limit(config.rate_write_per_second);
+  admission.heavy = rate_limit(config.rate_heavy_per_second);
+  admission.max_concurrent_heavy = config.max_concurrent_heavy;
+  platform::HttpResponse cors;
+  ApplyCors(cors);
+  admission.rejection_headers = cors.headers;
+  server.SetAdmissionPolicy(std::move(admission));
+  server.SetRequestTimeout(std::chrono::milliseconds(config.request_timeout_ms));
+}
+
+void SetStartupReport(const StartupReport& report) {
+  std::lock_guard<std::mutex> lock(startup_mutex);
+  startup_report = report;
 }
 
 ServerConfig LoadServerConfig() {
@@ -414,6 +1046,108 @@ ServerConfig LoadServerConfig() {
       config.seed_demo_data = false;
     }
   }
+  if (const char* cache = std::getenv("APIM_CPP_SLUG_CACHE")) {
+    const std::string value = cache;
+    if (value == "0" || value == "false" || value == "FALSE") {
+      config.slug_cache = false;
+    }
+  }
+  if (const char* single_flight = std::getenv("APIM_CPP_SINGLE_FLIGHT")) {
+    const std::string value = single_flight;
+    if (value == "0" || value == "false" || value == "FALSE") {
+      config.single_flight = false;
+    }
+  }
+  if (const char* snapshot_dir = std::getenv("APIM_CPP_SNAPSHOT_DIR")) {
+    config.snapshot_directory = snapshot_dir;
+  }
+  config.snapshot_interval_seconds =
+      ReadIntEnv("APIM_CPP_SNAPSHOT_INTERVAL_SECONDS", config.snapshot_interval_seconds, 0,
+                 7 * 24 * 3600);
+  config.snapshot_keep = ReadIntEnv("APIM_CPP_SNAPSHOT_KEEP", config.snapshot_keep, 1, 1000);
+  config.snapshot_pages_per_step = ReadIntEnv("APIM_CPP_SNAPSHOT_PAGES_PER_STEP",
+                                              config.snapshot_pages_per_step, 1, 1 << 20);
+  config.snapshot_step_pause_ms =
+      ReadIntEnv("APIM_CPP_SNAPSHOT_STEP_PAUSE_MS", config.snapshot_step_pause_ms, 0, 10000);
+  if (const char* profile = std::getenv("APIM_CPP_STORAGE_PROFILE")) {
+    try {
+      config.storage = StorageProfile(profile);
+    } catch (const std::exception& ex) {
+      LogWarn(std::string{ex.what()} + " Falling back to '" + config.storage.profile + "'.");
+    }
+  }
+  // Individual overrides win over the preset.
+  if (const char* synchronous = std::getenv("APIM_CPP_SQLITE_SYNCHRONOUS")) {
+    const std::string value = UpperCase(synchronous);
+    if (value == "OFF" || value == "NORMAL" || value == "FULL" || value == "EXTRA") {
+      config.storage.synchronous = value;
+    } else {
+      LogWarn("APIM_CPP_SQLITE_SYNCHRONOUS must be OFF, NORMAL, FULL, or EXTRA; ignoring");
+    }
+  }
+  if (const char* temp_store = std::getenv("APIM_CPP_SQLITE_TEMP_STORE")) {
+    const std::string value = UpperCase(temp_store);
+    if (value == "DEFAULT" || value == "FILE" || value == "MEMORY") {
+      config.storage.temp_store = value;
+    } else {
+      LogWarn("APIM_CPP_SQLITE_TEMP_STORE must be DEFAULT, FILE, or MEMORY; ignoring");
+    }
+  }
+  config.storage.cache_size_kib = ReadIntEnv(
+      "APIM_CPP_SQLITE_CACHE_SIZE_KIB", static_cast<int>(config.storage.cache_size_kib), 0,
+      64 * 1024 * 1024);
+  config.storage.mmap_size_bytes =
+      static_cast<std::int64_t>(ReadIntEnv("APIM_CPP_SQLITE_MMAP_SIZE_MB",
+                                           static_cast<int>(config.storage.mmap_size_bytes >> 20),
+                                           0, 1024 * 1024))
+      << 20;
+  config.storage.wal_autocheckpoint_pages =
+      ReadIntEnv("APIM_CPP_SQLITE_WAL_AUTOCHECKPOINT", config.storage.wal_autocheckpoint_pages, 0,
+                 1 << 24);
+  config.storage.busy_timeout_ms = ReadIntEnv("APIM_CPP_SQLITE_BUSY_TIMEOUT_MS",
+                                              config.storage.busy_timeout_ms, 0, 10 * 60 * 1000);
+  config.wal_checkpoint_interval_ms = ReadIntEnv(
+      "APIM_CPP_WAL_CHECKPOINT_INTERVAL_MS", config.wal_checkpoint_interval_ms, 0, 60 * 60 * 1000);
+  config.wal_checkpoint_pages =
+      ReadIntEnv("APIM_CPP_WAL_CHECKPOINT_PAGES", config.wal_checkpoint_pages, 1, 1 << 24);
+  config.wal_truncate_idle_ms = ReadIntEnv("APIM_CPP_WAL_TRUNCATE_IDLE_MS",
+                                           config.wal_truncate_idle_ms, 0, 24 * 60 * 60 * 1000);
+  config.history_max_age_days =
+      ReadIntEnv("APIM_CPP_HISTORY_MAX_AGE_DAYS", config.history_max_age_days, 0, 36500);
+  config.history_max_per_slug =
+      ReadIntEnv("APIM_CPP_HISTORY_MAX_PER_SLUG", config.history_max_per_slug, 0, 1000000);
+  config.history_downsample_after_hours = ReadIntEnv(
+      "APIM_CPP_HISTORY_DOWNSAMPLE_AFTER_HOURS", config.history_downsample_after_hours, 0, 876000);
+  config.history_downsample_bucket_minutes =
+      ReadIntEnv("APIM_CPP_HISTORY_DOWNSAMPLE_BUCKET_MINUTES",
+                 config.history_downsample_bucket_minutes, 1, 525600);
+  config.history_retention_interval_seconds =
+      ReadIntEnv("APIM_CPP_HISTORY_RETENTION_INTERVAL_SECONDS",
+                 config.history_retention_interval_seconds, 1, 7 * 24 * 3600);
+  config.history_retention_batch =
+      ReadIntEnv("APIM_CPP_HISTORY_RETENTION_BATCH", config.history_retention_batch, 1, 100000);
+  if (const char* unix_socket = std::getenv("APIM_CPP_UNIX_SOCKET")) {
+    config.unix_socket_path = unix_socket;
+  }
+  config.request_timeout_ms =
+      ReadIntEnv("APIM_CPP_REQUEST_TIMEOUT_MS", config.request_timeout_ms, 0, 24 * 3600 * 1000);
+  config.rate_read_per_second =
+      ReadIntEnv("APIM_CPP_RATE_READ_PER_SECOND", config.rate_read_per_second, 0, 1000000);
+  config.rate_write_per_second =
+      ReadIntEnv("APIM_CPP_RATE_WRITE_PER_SECOND", config.rate_write_per_second, 0, 1000000);
+  config.rate_heavy_per_second =
+      ReadIntEnv("APIM_CPP_RATE_HEAVY_PER_SECOND", config.rate_heavy_per_second, 0, 1000000);
+  config.rate_burst_seconds =
+      ReadIntEnv("APIM_CPP_RATE_BURST_SECONDS", config.rate_burst_seconds, 1, 3600);
+  config.max_concurrent_heavy =
+      ReadIntEnv("APIM_CPP_MAX_CONCURRENT_HEAVY", config.max_concurrent_heavy, 0, 1024);
+  config.mcp_max_result_bytes = ReadIntEnv("APIM_CPP_MCP_MAX_RESULT_BYTES",
+                                           config.mcp_max_result_bytes, 0, 1 << 30);
+  if (const char* restore_from = std::getenv("APIM_CPP_RESTORE_FROM")) {
+    config.restore_from = restore_from;
+  }
+  config.warmup_budget_ms =
+      ReadIntEnv("APIM_CPP_WARMUP_BUDGET_MS", config.warmup_budget_ms, 0, 10 * 60 * 1000);
   return config;
 }
 
@@ -1,7 +1,10 @@
 #pragma once
 
+#include <cstdint>
 #include <string>
 
+#include "core/storage_settings.hpp"
+
 namespace core {
 class ChecklistStore;
 }
@@ -15,11 +18,66 @@ namespace core {
 struct ServerConfig {
   std::string host = "127.0.0.1";
   int port = 8080;
+  std::string unix_socket_path;  // also serve on this Unix domain socket when set (POSIX only)
   std::string database_path = ".apim/checklists.db";
   bool seed_demo_data = true;
+  StorageSettings storage;
+  // Background WAL checkpointing; an interval of 0 leaves checkpoints to SQLite's autocheckpoint.
+  int wal_checkpoint_interval_ms = 1000;
+  int wal_checkpoint_pages = 1000;
+  int wal_truncate_idle_ms = 30000;
+  bool slug_cache = true;  // columnar in-memory cache for slug reads and exports
+  bool single_flight = true;  // identical concurrent read-heavy GETs share one computation
+
+  // History retention; all rules 0 leaves history untouched.
+  int history_max_age_days = 0;
+  int history_max_per_slug = 0;
+  int history_downsample_after_hours = 0;
+  int history_downsample_bucket_minutes = 60;
+  int history_retention_interval_seconds = 3600;
+  int history_retention_batch = 200;
+
+  std::string snapshot_directory = ".apim/snapshots";
+  int snapshot_interval_seconds = 0;  // 0 disables scheduled snapshots
+  int snapshot_keep = 7;
+  int snapshot_pages_per_step = 256;
+  int snapshot_step_pause_ms = 5;
+
+  // Deadline for socket requests, checked between row batches in long store operations (which
+  // then roll back); 0 leaves requests unbounded unless they send X-Request-Timeout-Ms.
+  int request_timeout_ms = 0;
+
+  // Admission control: token buckets per client address and route class (0 admits everything),
+  // plus a server-wide cap on concurrent exports, imports and snapshots (0 is unlimited).
+  int rate_read_per_second = 0;
+  int rate_write_per_second = 0;
+  int rate_heavy_per_second = 0;
+  int rate_burst_seconds = 2;
+  int max_concurrent_heavy = 4;
+
+  // Byte budget for each /mcp tool result (compact output); 0 returns results whole.
+  int mcp_max_result_bytes = 0;
+
+  std::string restore_from;  // snapshot swapped in before the store opens
+  int warmup_budget_ms = 0;  // 0 skips the warm-up phase
 };
 
-void ConfigureServer(platform::HttpServer& server, ChecklistStore& store);
+// Timings for the path from process start to an open listener, reported by /api/health.
+struct StartupReport {
+  std::string restored_from;
+  std::int64_t restore_ms = 0;
+  std::int64_t open_ms = 0;
+  std::int64_t warmup_ms = 0;
+  std::int64_t warmup_bytes = 0;
+  std::int64_t warmup_rows = 0;
+  bool warmup_complete = true;
+  std::int64_t ready_ms = 0;
+};
+
+void SetStartupReport(const StartupReport& report);
+
+void ConfigureServer(platform::HttpServer& server, ChecklistStore& store,
+                     const ServerConfig& config = ServerConfig{});
 ServerConfig LoadServerConfig();
 
 }  // namespace core
@@ -2,21 +2,28 @@
 
 #include <algorithm>
 #include <array>
+#include <atomic>
 #include <chrono>
 #include <ctime>
 #include <filesystem>
+#include <fstream>
 #include <iomanip>
 #include <sstream>
 #include <stdexcept>
 #include <string_view>
+#include <thread>
+#include <unordered_map>
 #include <cctype>
 
 #include "core/logging.hpp"
+#include "core/slug_cache.hpp"
+#include "core/slug_cursor.hpp"
 #include "sqlite3.h"
 #include "xxhash.h"
 
 namespace {
 
+using core::Cancellation;
 using core::ChecklistSlug;
 using core::ChecklistStatus;
 using core::RelationshipEdge;
@@ -258,12 +265,121 @@ void StepOrThrow(sqlite3_stmt* stmt, const std::string& context) {
   }
 }
 
+void BindOrThrow(int rc, const std::string& context) {
+  if (rc != SQLITE_OK) {
+    throw std::runtime_error(context + " bind failed: " + std::string(sqlite3_errstr(rc)));
+  }
+}
+
+void ExecOrThrow(sqlite3* db, const char* sql, const std::string& context) {
+  char* errmsg = nullptr;
+  if (sqlite3_exec(db, sql, nullptr, nullptr, &errmsg) != SQLITE_OK) {
+    std::string message = errmsg ? errmsg : sqlite3_errmsg(db);
+    sqlite3_free(errmsg);
+    throw std::runtime_error(context + " failed: " + message);
+  }
+}
+
+// EnsureSchema's migration steps, in the order they run. All steps share the one
+// PRAGMA user_version counter: each runs once while user_version is below its constant and then
+// sets user_version to it. Steps are only ever appended with the next number; to change a derived
+// table's layout, append a step that rebuilds it rather than renumbering or editing an old one.
+constexpr int64_t kReadModelSchemaVersion = 1;
+constexpr int64_t kSearchSchemaVersion = 2;
+constexpr int64_t kRollupSchemaVersion = 3;
+constexpr int64_t kSearchKeysSchemaVersion = 4;
+
+std::string SetUserVersionSql(int64_t version) {
+  return "PRAGMA user_version=" + std::to_string(version) + ";";
+}
+// Column order matches BuildSlug.
+constexpr const char* kReadModelColumns =
+    "SELECT address_id, checklist, section, procedure, action, spec, result, status, comment, "
+    "timestamp, instructions FROM slug_read_model ";
+
+// Turns free text into an FTS5 query of quoted terms so operators never need (or trip over) the
+// MATCH syntax; the last term is a prefix so partially typed words still match.
+std::string BuildFtsQuery(const std::string& text) {
+  std::string query;
+  std::istringstream words(text);
+  std::string word;
+  while (words >> word) {
+    if (!query.empty()) {
+      query += ' ';
+    }
+    query += '"';
+    for (const char ch : word) {
+      query += ch;
+      if (ch == '"') {
+        query += '"';
+      }
+    }
+    query += '"';
+  }
+  if (query.empty()) {
+    throw std::invalid_argument("Search text must contain at least one word.");
+  }
+  return query + '*';
+}
+
 std::string ToLower(std::string value) {
   std::transform(value.begin(), value.end(), value.begin(),
                  [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
   return value;
 }
 
+constexpr std::array<const char*, 4> kSynchronousModes = {"OFF", "NORMAL", "FULL", "EXTRA"};
+constexpr std::array<const char*, 3> kTempStoreModes = {"DEFAULT", "FILE", "MEMORY"};
+
+template <std::size_t N>
+const char* CheckedMode(const std::array<const char*, N>& modes, const std::string& value,
+                        const char* pragma) {
+  for (const char* mode : modes) {
+    if (ToLower(value) == ToLower(mode)) {
+      return mode;
+    }
+  }
+  throw std::invalid_argument(std::string{"Unsupported "} + pragma + " value: " + value);
+}
+
+int64_t PragmaInt(sqlite3* db, const std::string& pragma) {
+  sqlite3_stmt* stmt = nullptr;
+  if (Prepare(db, "PRAGMA " + pragma + ";", &stmt) != SQLITE_OK) {
+    Finalize(stmt);
+    throw std::runtime_error("Failed to read PRAGMA " + pragma);
+  }
+  const int64_t value = sqlite3_step(stmt) == SQLITE_ROW ? ColumnInt64(stmt, 0) : 0;
+  Finalize(stmt);
+  return value;
+}
+
+// Steps `stmt` to its next row, first letting `cancel` stop the read at a batch boundary (`row` is
+// the number of rows read so far). The statement is finalized before the cancellation propagates.
+bool NextRow(sqlite3_stmt*& stmt, const Cancellation& cancel, std::size_t row) {
+  try {
+    cancel.ThrowIfCancelled(row);
+  } catch (...) {
+    Finalize(stmt);
+    stmt = nullptr;
+    throw;
+  }
+  return sqlite3_step(stmt) == SQLITE_ROW;
+}
+
+// Advances the store's write generation when a write method's scope ends, committed or not.
+// Declared after the store lock so the bump lands before the lock is released.
+class WriteGenerationBump {
+ public:
+  explicit WriteGenerationBump(std::atomic<std::uint64_t>& generation) : generation_(generation) {}
+  ~WriteGenerationBump() { generation_.fetch_add(1, std::memory_order_release); }
+
+  WriteGenerationBump(const WriteGenerationBump&) = delete;
+  WriteGenerationBump& operator=(const WriteGenerationBump&) = delete;
+
+ private:
+  std::atomic<std::uint64_t>& generation_;
+};
+
 }  // namespace
 
 namespace core {
@@ -301,9 +417,10 @@ std::string StatusToString(ChecklistStatus status) {
   }
 }
 
-std::string CurrentTimestampIsoUtc() {
-  const auto now = std::chrono::system_clock::now();
-  const std::time_t time = std::chrono::system_clock::to_time_t(now);
+std::string CurrentTimestampIsoUtc() { return FormatIsoUtc(std::chrono::system_clock::now()); }
+
+std::string FormatIsoUtc(std::chrono::system_clock::time_point when) {
+  const std::time_t time = std::chrono::system_clock::to_time_t(when);
   std::tm tm_snapshot{};
 #if defined(_WIN32)
   gmtime_s(&tm_snapshot, &time);
@@ -329,9 +446,39 @@ std::string ComputeAddressId(const std::string& checklist, const std::string& se
   return EncodeBase32(truncated);
 }
 
-ChecklistStore::ChecklistStore(std::string db_path) : db_path_(std::move(db_path)) {}
+StorageSettings StorageProfile(const std::string& name) {
+  StorageSettings settings;
+  settings.profile = ToLower(name);
+  if (settings.profile == "balanced") {
+    settings.synchronous = "NORMAL";
+    settings.cache_size_kib = 64 * 1024;
+    settings.mmap_size_bytes = 256LL * 1024 * 1024;
+    settings.temp_store = "MEMORY";
+  } else if (settings.profile == "throughput") {
+    settings.synchronous = "OFF";
+    settings.cache_size_kib = 256 * 1024;
+    settings.mmap_size_bytes = 1024LL * 1024 * 1024;
+    settings.temp_store = "MEMORY";
+    settings.wal_autocheckpoint_pages = 4000;
+  } else if (settings.profile != "durable") {
+    throw std::invalid_argument("Unknown storage profile '" + name +
+                                "' (expected durable, balanced, or throughput).");
+  }
+  return settings;
+}
+
+ChecklistStore::ChecklistStore(std::string db_path, StorageSettings storage)
+    : db_path_(std::move(db_path)),
+      storage_(std::move(storage)),
+      slug_cache_(std::make_unique<SlugCache>()) {}
 
 ChecklistStore::~ChecklistStore() {
+  if (wal_checkpointer_) {
+    if (db_) {
+      sqlite3_wal_hook(db_, nullptr, nullptr);
+    }
+    wal_checkpointer_->Stop();
+  }
   if (db_) {
     sqlite3_close(db_);
     db_ = nullptr;
@@ -371,6 +518,11 @@ void ChecklistStore::Initialize(bool seed_demo_data) {
     }
   }
 
+  ApplyStorageSettings();
+  effective_storage_ = ReadStorageSettings();
+  effective_wal_autocheckpoint_pages_.store(effective_storage_.wal_autocheckpoint_pages,
+                                            std::memory_order_relaxed);
+
   EnsureSchema();
 
   if (seed_demo_data && !HasAnySlugs()) {
@@ -378,6 +530,95 @@ void ChecklistStore::Initialize(bool seed_demo_data) {
   }
 }
 
+void ChecklistStore::ApplyStorageSettings() {
+  // Negative cache_size is in KiB rather than pages, so it does not depend on page_size.
+  const std::string pragmas =
+      std::string{"PRAGMA synchronous="} +
+      CheckedMode(kSynchronousModes, storage_.synchronous, "synchronous") + ";" +
+      "PRAGMA cache_size=" + std::to_string(-std::max<int64_t>(storage_.cache_size_kib, 0)) +
+      ";" + "PRAGMA mmap_size=" + std::to_string(std::max<int64_t>(storage_.mmap_size_bytes, 0)) +
+      ";" + "PRAGMA temp_store=" + CheckedMode(kTempStoreModes, storage_.temp_store, "temp_store") +
+      ";" + "PRAGMA wal_autocheckpoint=" +
+      std::to_string(std::max(storage_.wal_autocheckpoint_pages, 0)) + ";";
+  ExecOrThrow(db_, pragmas.c_str(), "Applying storage profile '" + storage_.profile + "'");
+  sqlite3_busy_timeout(db_, std::max(storage_.busy_timeout_ms, 0));
+  LogInfo("Storage profile '" + storage_.profile + "' applied");
+}
+
+void ChecklistStore::StartWalCheckpointer(const WalCheckpointPolicy& policy) {
+  ProfiledLock lock(mutex_, lock_profiler_, "StartWalCheckpointer");
+  if (wal_checkpointer_) {
+    return;
+  }
+  if (db_path_ == ":memory:" || db_path_.empty()) {
+    LogInfo("WAL checkpointer skipped for in-memory database");
+    return;
+  }
+  auto checkpointer = std::make_unique<WalCheckpointer>(db_path_, policy);
+  checkpointer->Start();
+  // Installing a WAL hook replaces SQLite's autocheckpoint hook, so commits only notify.
+  sqlite3_wal_hook(
+      db_,
+      [](void* context, sqlite3*, const char*, int pages) {
+        static_cast<WalCheckpointer*>(context)->NotifyCommit(pages);
+        return SQLITE_OK;
+      },
+      checkpointer.get());
+  wal_checkpointer_ = std::move(checkpointer);
+  effective_wal_autocheckpoint_pages_.store(
+      static_cast<int>(PragmaInt(db_, "wal_autocheckpoint")), std::memory_order_relaxed);
+}
+
+std::optional<WalCheckpointStats> ChecklistStore::WalCheckpointerStats() const {
+  ProfiledLock lock(mutex_, lock_profiler_, "WalCheckpointerStats");
+  if (!wal_checkpointer_) {
+    return std::nullopt;
+  }
+  return wal_checkpointer_->Stats();
+}
+
+void ChecklistStore::SetSlugCacheEnabled(bool enabled) { slug_cache_->SetEnabled(enabled); }
+
+SlugCacheStats ChecklistStore::CachedSlugStats() const { return slug_cache_->Stats(); }
+
+void Cancellation::ThrowIfCancelled() const {
+  if (std::chrono::steady_clock::now() >= deadline) {
+    throw OperationCancelled("Request deadline exceeded.", /*deadline_exceeded=*/true);
+  }
+  if (abandoned && abandoned()) {
+    throw OperationCancelled("Request abandoned by the client.", /*deadline_exceeded=*/false);
+  }
+}
+
+std::uint64_t ChecklistStore::WriteGeneration() const {
+  return write_generation_.load(std::memory_order_acquire);
+}
+
+StorageSettings ChecklistStore::EffectiveStorageSettings() const {
+  StorageSettings effective = effective_storage_;
+  effective.wal_autocheckpoint_pages =
+      effective_wal_autocheckpoint_pages_.load(std::memory_order_relaxed);
+  return effective;
+}
+
+StorageSettings ChecklistStore::ReadStorageSettings() const {
+  StorageSettings effective;
+  effective.profile = storage_.profile;
+  const auto synchronous = static_cast<std::size_t>(PragmaInt(db_, "synchronous"));
+  effective.synchronous =
+      synchronous < kSynchronousModes.size() ? kSynchronousModes[synchronous] : "UNKNOWN";
+  const int64_t cache_size = PragmaInt(db_, "cache_size");
+  effective.cache_size_kib =
+      cache_size < 0 ? -cache_size : cache_size * PragmaInt(db_, "page_size") / 1024;
+  effective.mmap_size_bytes = PragmaInt(db_, "mmap_size");
+  const auto temp_store = static_cast<std::size_t>(PragmaInt(db_, "temp_store"));
+  effective.temp_store =
+      temp_store < kTempStoreModes.size() ? kTempStoreModes[temp_store] : "UNKNOWN";
+  effective.wal_autocheckpoint_pages = static_cast<int>(PragmaInt(db_, "wal_autocheckpoint"));
+  effective.busy_timeout_ms = static_cast<int>(PragmaInt(db_, "busy_timeout"));
+  return effective;
+}
+
 void ChecklistStore::EnsureSchema() {
   try {
     const auto columns = TableColumns(db_, "slugs");
@@ -393,6 +634,10 @@ void ChecklistStore::EnsureSchema() {
     if (!columns.empty() && (!has_fk_columns || has_legacy_text_columns)) {
       LogInfo("Dropping legacy slugs schema to apply normalized schema");
       const char* drop_sql =
+          "DROP TABLE IF EXISTS status_rollup;"
+          "DROP TABLE IF EXISTS slug_search_keys;"
+          "DROP TABLE IF EXISTS slug_search;"
+          "DROP TABLE IF EXISTS slug_read_model;"
           "DROP TABLE IF EXISTS relationships;"
           "DROP TABLE IF EXISTS history;"
           "DROP TABLE IF EXISTS slugs;"
@@ -487,6 +732,56 @@ void ChecklistStore::EnsureSchema() {
         PRIMARY KEY (address_id, timestamp)
     );
 
+    -- Denormalized copy of each slug with its template names resolved, so reads are a single
+    -- index probe instead of a six-way join. Maintained by UpsertSlugUnlocked/ApplyUpdateUnlocked.
+    CREATE TABLE IF NOT EXISTS slug_read_model (
+        address_id    TEXT PRIMARY KEY,
+        checklist     TEXT NOT NULL,
+        section       TEXT NOT NULL,
+        procedure     TEXT NOT NULL,
+        action        TEXT NOT NULL,
+        spec          TEXT NOT NULL,
+        result        TEXT,
+        status        TEXT,
+        comment       TEXT,
+        timestamp     TEXT,
+        instructions  TEXT,
+        FOREIGN KEY(address_id) REFERENCES slugs(address_id) ON DELETE CASCADE
+    ) WITHOUT ROWID;
+
+    -- Full-text index over the searchable template text, maintained by UpsertSlugUnlocked and
+    -- ReplaceChecklist. Entries are found through slug_search_keys by address_id, never through
+    -- `slugs` rowids: `slugs` has no INTEGER PRIMARY KEY, so VACUUM may renumber those.
+    CREATE VIRTUAL TABLE IF NOT EXISTS slug_search USING fts5(
+        address_id UNINDEXED,
+        checklist UNINDEXED,
+        action,
+        spec,
+        instructions,
+        tokenize = 'porter unicode61',
+        prefix = '2 3'
+    );
+
+    -- The slug_search rowid holding each slug's entry. FTS5 rowids survive VACUUM.
+    CREATE TABLE IF NOT EXISTS slug_search_keys (
+        address_id    TEXT PRIMARY KEY,
+        search_rowid  INTEGER NOT NULL,
+        FOREIGN KEY(address_id) REFERENCES slugs(address_id) ON DELETE CASCADE
+    ) WITHOUT ROWID;
+
+    -- Slug counts per status for every checklist (level 0), section (1) and procedure (2), kept
+    -- current incrementally by UpsertSlugUnlocked/ApplyUpdateUnlocked and cleared per checklist by
+    -- ReplaceChecklist. Names below a row's level are ''.
+    CREATE TABLE IF NOT EXISTS status_rollup (
+        checklist  TEXT NOT NULL,
+        level      INTEGER NOT NULL,
+        section    TEXT NOT NULL,
+        procedure  TEXT NOT NULL,
+        status     TEXT NOT NULL,
+        count      INTEGER NOT NULL,
+        PRIMARY KEY (level, checklist, section, procedure, status)
+    ) WITHOUT ROWID;
+
     CREATE INDEX IF NOT EXISTS idx_slugs_checklist_id  ON slugs(checklist_id);
     CREATE INDEX IF NOT EXISTS idx_slugs_section_id    ON slugs(section_id);
     CREATE INDEX IF NOT EXISTS idx_slugs_procedure_id  ON slugs(procedure_id);
@@ -494,7 +789,11 @@ void ChecklistStore::EnsureSchema() {
     CREATE INDEX IF NOT EXISTS idx_slugs_spec_id       ON slugs(spec_id);
     CREATE INDEX IF NOT EXISTS idx_relationships_subject ON relationships(subject_id);
     CREATE INDEX IF NOT EXISTS idx_relationships_target  ON relationships(target_id);
-    CREATE INDEX IF NOT EXISTS idx_history_address ON history(address_id);
+    -- The (address_id, timestamp) primary key already serves per-slug lookups; this duplicate
+    -- index only cost a write per history row.
+    DROP INDEX IF EXISTS idx_history_address;
+    CREATE INDEX IF NOT EXISTS idx_read_model_order
+        ON slug_read_model(checklist, section, procedure, action);
   )sql";
 
   char* errmsg = nullptr;
@@ -504,10 +803,64 @@ void ChecklistStore::EnsureSchema() {
     sqlite3_free(errmsg);
     throw std::runtime_error("Failed to initialize schema: " + message);
   }
+
+  // Databases written before the read model existed (or restored from such a snapshot) are
+  // backfilled once from the normalized tables; user_version records that it has been done.
+  if (PragmaInt(db_, "user_version") < kReadModelSchemaVersion) {
+    LogInfo("Building slug read model");
+    const std::string sql =
+        "BEGIN IMMEDIATE;"
+        "DELETE FROM slug_read_model;"
+        "INSERT INTO slug_read_model (address_id, checklist, section, procedure, action, "
+        "spec, result, status, comment, timestamp, instructions) "
+        "SELECT s.address_id, c.name, sec.name, p.name, a.name, sp.text, s.result, "
+        "s.status, s.comment, s.timestamp, s.instructions "
+        "FROM slugs s "
+        "JOIN checklists c ON s.checklist_id = c.id "
+        "JOIN sections sec ON s.section_id = sec.id "
+        "JOIN procedures p ON s.procedure_id = p.id "
+        "JOIN actions a ON s.action_id = a.id "
+        "JOIN specs sp ON s.spec_id = sp.id;" +
+        SetUserVersionSql(kReadModelSchemaVersion) + "COMMIT;";
+    ExecOrThrow(db_, sql.c_str(), "Building slug read model");
+  }
+  if (PragmaInt(db_, "user_version") < kSearchSchemaVersion) {
+    // This step built slug_search keyed by `slugs` rowids; the kSearchKeysSchemaVersion step
+    // below rebuilds it keyed by address_id, so only the version is recorded here.
+    ExecOrThrow(db_, SetUserVersionSql(kSearchSchemaVersion).c_str(),
+                "Recording slug search index version");
+  }
+  if (PragmaInt(db_, "user_version") < kRollupSchemaVersion) {
+    LogInfo("Building status roll-up");
+    const std::string sql =
+        "BEGIN IMMEDIATE;"
+        "DELETE FROM status_rollup;"
+        "INSERT INTO status_rollup SELECT checklist, 0, '', '', status, COUNT(*) "
+        "FROM slug_read_model GROUP BY checklist, status;"
+        "INSERT INTO status_rollup SELECT checklist, 1, section, '', status, COUNT(*) "
+        "FROM slug_read_model GROUP BY checklist, section, status;"
+        "INSERT INTO status_rollup SELECT checklist, 2, section, procedure, status, "
+        "COUNT(*) FROM slug_read_model GROUP BY checklist, section, procedure, status;" +
+        SetUserVersionSql(kRollupSchemaVersion) + "COMMIT;";
+    ExecOrThrow(db_, sql.c_str(), "Building status roll-up");
+  }
+  if (PragmaInt(db_, "user_version") < kSearchKeysSchemaVersion) {
+    LogInfo("Building slug search index");
+    const std::string sql =
+        "BEGIN IMMEDIATE;"
+        "DELETE FROM slug_search_keys;"
+        "DELETE FROM slug_search;"
+        "INSERT INTO slug_search (address_id, checklist, action, spec, instructions) "
+        "SELECT address_id, checklist, action, spec, instructions FROM slug_read_model;"
+        "INSERT INTO slug_search_keys (address_id, search_rowid) "
+        "SELECT address_id, rowid FROM slug_search;" +
+        SetUserVersionSql(kSearchKeysSchemaVersion) + "COMMIT;";
+    ExecOrThrow(db_, sql.c_str(), "Building slug search index");
+  }
 }
 
 bool ChecklistStore::HasAnySlugs() const {
-  std::lock_guard<std::mutex> lock(mutex_);
+  ProfiledLock lock(mutex_, lock_profiler_, "HasAnySlugs");
   sqlite3_stmt* stmt = nullptr;
   if (Prepare(db_, "SELECT 1 FROM slugs LIMIT 1;", &stmt) != SQLITE_OK) {
     Finalize(stmt);
@@ -586,7 +939,9 @@ void ChecklistStore::SeedDemoData() {
 }
 
 void ChecklistStore::UpsertSlug(const ChecklistSlug& slug) {
-  std::lock_guard<std::mutex> lock(mutex_);
+  ProfiledLock lock(mutex_, lock_profiler_, "UpsertSlug");
+  const WriteGenerationBump bump(write_generation_);
+  slug_cache_->Clear();
   UpsertSlugUnlocked(slug);
 }
 
@@ -597,7 +952,21 @@ void ChecklistStore::UpsertSlugUnlocked(const ChecklistSlug& slug) {
   const int64_t action_id = ResolveActionId(db_, procedure_id, slug.action);
   const int64_t spec_id = ResolveSpecId(db_, action_id, slug.spec);
 
+  // The template names are part of the Address ID, so only the status counter can move.
+  std::optional<ChecklistStatus> previous_status;
   sqlite3_stmt* stmt = nullptr;
+  if (Prepare(db_, "SELECT status FROM slug_read_model WHERE address_id=?;", &stmt) !=
+      SQLITE_OK) {
+    Finalize(stmt);
+    throw std::runtime_error("Failed to prepare slug status lookup");
+  }
+  sqlite3_bind_text(stmt, 1, slug.address_id.c_str(), -1, SQLITE_TRANSIENT);
+  if (sqlite3_step(stmt) == SQLITE_ROW) {
+    previous_status = ParseStatus(ColumnText(stmt, 0));
+  }
+  Finalize(stmt);
+
+  stmt = nullptr;
   const std::string sql =
       "INSERT INTO slugs (address_id, checklist_id, section_id, procedure_id, action_id, spec_id, "
       "result, status, comment, timestamp, instructions) VALUES (?,?,?,?,?,?,?,?,?,?,?) "
@@ -623,11 +992,88 @@ void ChecklistStore::UpsertSlugUnlocked(const ChecklistSlug& slug) {
 
   StepOrThrow(stmt, "slug upsert");
   Finalize(stmt);
+
+  // Template names are part of the Address ID, so an existing row only ever changes state.
+  stmt = nullptr;
+  const std::string read_model_sql =
+      "INSERT INTO slug_read_model (address_id, checklist, section, procedure, action, spec, "
+      "result, status, comment, timestamp, instructions) VALUES (?,?,?,?,?,?,?,?,?,?,?) "
+      "ON CONFLICT(address_id) DO UPDATE SET result=excluded.result, status=excluded.status, "
+      "comment=excluded.comment, timestamp=excluded.timestamp, instructions=excluded.instructions;";
+  if (Prepare(db_, read_model_sql, &stmt) != SQLITE_OK) {
+    Finalize(stmt);
+    throw std::runtime_error("Failed to prepare read model upsert");
+  }
+  const std::string status = StatusToString(slug.status);
+  const std::string* values[] = {&slug.address_id, &slug.checklist, &slug.section,
+                                 &slug.procedure,  &slug.action,    &slug.spec,
+                                 &slug.result,     &status,         &slug.comment,
+                                 &slug.timestamp,  &slug.instructions};
+  for (int i = 0; i < 11; ++i) {
+    sqlite3_bind_text(stmt, i + 1, values[i]->c_str(), -1, SQLITE_TRANSIENT);
+  }
+  StepOrThrow(stmt, "read model upsert");
+  Finalize(stmt);
+
+  // Replaces the slug's existing entry in place, or adds one (rowid NULL lets FTS5 pick it) and
+  // records where it went.
+  const char* search_sql[] = {
+      "INSERT OR REPLACE INTO slug_search "
+      "(rowid, address_id, checklist, action, spec, instructions) VALUES "
+      "((SELECT search_rowid FROM slug_search_keys WHERE address_id=?1), ?1, ?2, ?3, ?4, ?5);",
+      "INSERT OR IGNORE INTO slug_search_keys (address_id, search_rowid) "
+      "VALUES (?1, last_insert_rowid());",
+  };
+  const std::string* search_values[] = {&slug.address_id, &slug.checklist, &slug.action,
+                                        &slug.spec, &slug.instructions};
+  for (const char* sql : search_sql) {
+    stmt = nullptr;
+    if (Prepare(db_, sql, &stmt) != SQLITE_OK) {
+      Finalize(stmt);
+      throw std::runtime_error("Failed to prepare search index upsert");
+    }
+    for (int i = 0; i < sqlite3_bind_parameter_count(stmt); ++i) {
+      sqlite3_bind_text(stmt, i + 1, search_values[i]->c_str(), -1, SQLITE_TRANSIENT);
+    }
+    StepOrThrow(stmt, "search index upsert");
+    Finalize(stmt);
+  }
+
+  if (previous_status != slug.status) {
+    if (previous_status) {
+      AdjustStatusRollup(slug.checklist, slug.section, slug.procedure, *previous_status, -1);
+    }
+    AdjustStatusRollup(slug.checklist, slug.section, slug.procedure, slug.status, 1);
+  }
+}
+
+void ChecklistStore::AdjustStatusRollup(const std::string& checklist, const std::string& section,
+                                        const std::string& procedure, ChecklistStatus status,
+                                        int delta) {
+  sqlite3_stmt* stmt = nullptr;
+  if (Prepare(db_,
+              "INSERT INTO status_rollup (checklist, level, section, procedure, status, count) "
+              "VALUES (?1, 0, '', '', ?4, ?5), (?1, 1, ?2, '', ?4, ?5), (?1, 2, ?2, ?3, ?4, ?5) "
+              "ON CONFLICT DO UPDATE SET count = count + excluded.count;",
+              &stmt) != SQLITE_OK) {
+    Finalize(stmt);
+    throw std::runtime_error("Failed to prepare status roll-up update");
+  }
+  const std::string status_text = StatusToString(status);
+  sqlite3_bind_text(stmt, 1, checklist.c_str(), -1, SQLITE_TRANSIENT);
+  sqlite3_bind_text(stmt, 2, section.c_str(), -1, SQLITE_TRANSIENT);
+  sqlite3_bind_text(stmt, 3, procedure.c_str(), -1, SQLITE_TRANSIENT);
+  sqlite3_bind_text(stmt, 4, status_text.c_str(), -1, SQLITE_TRANSIENT);
+  sqlite3_bind_int(stmt, 5, delta);
+  StepOrThrow(stmt, "status roll-up update");
+  Finalize(stmt);
 }
 
 void ChecklistStore::ReplaceRelationships(const std::string& subject_id,
                                           const std::vector<RelationshipEdge>& edges) {
-  std::lock_guard<std::mutex> lock(mutex_);
+  ProfiledLock lock(mutex_, lock_profiler_, "ReplaceRelationships");
+  const WriteGenerationBump bump(write_generation_);
+  slug_cache_->Clear();
 
   char* errmsg = nullptr;
   sqlite3_exec(db_, "BEGIN IMMEDIATE;", nullptr, nullptr, &errmsg);
@@ -668,18 +1114,12 @@ void ChecklistStore::ReplaceRelationships(const std::string& subject_id,
 }
 
 ChecklistSlug ChecklistStore::GetSlugOrThrow(const std::string& address_id) const {
-  std::lock_guard<std::mutex> lock(mutex_);
+  if (auto cached = slug_cache_->GetSlug(address_id)) {
+    return std::move(*cached);
+  }
+  ProfiledLock lock(mutex_, lock_profiler_, "GetSlugOrThrow");
   sqlite3_stmt* stmt = nullptr;
-  const std::string sql =
-      "SELECT s.address_id, c.name, sec.name, p.name, a.name, sp.text, s.result, s.status, "
-      "s.comment, s.timestamp, s.instructions "
-      "FROM slugs s "
-      "JOIN checklists c ON s.checklist_id = c.id "
-      "JOIN sections sec ON s.section_id = sec.id "
-      "JOIN procedures p ON s.procedure_id = p.id "
-      "JOIN actions a ON s.action_id = a.id "
-      "JOIN specs sp ON s.spec_id = sp.id "
-      "WHERE s.address_id=?;";
+  const std::string sql = std::string{kReadModelColumns} + "WHERE address_id=?;";
   if (Prepare(db_, sql, &stmt) != SQLITE_OK) {
     Finalize(stmt);
     throw std::runtime_error("Failed to prepare slug lookup");
@@ -698,21 +1138,15 @@ ChecklistSlug ChecklistStore::GetSlugOrThrow(const std::string& address_id) cons
 }
 
 std::vector<ChecklistSlug> ChecklistStore::GetSlugsForChecklist(
-    const std::string& checklist) const {
+    const std::string& checklist, const Cancellation& cancel) const {
+  if (auto cached = slug_cache_->GetChecklist(checklist)) {
+    return std::move(*cached);
+  }
   std::vector<ChecklistSlug> slugs;
-  std::lock_guard<std::mutex> lock(mutex_);
+  ProfiledLock lock(mutex_, lock_profiler_, "GetSlugsForChecklist");
   sqlite3_stmt* stmt = nullptr;
-  const std::string sql =
-      "SELECT s.address_id, c.name, sec.name, p.name, a.name, sp.text, s.result, s.status, "
-      "s.comment, s.timestamp, s.instructions "
-      "FROM slugs s "
-      "JOIN checklists c ON s.checklist_id = c.id "
-      "JOIN sections sec ON s.section_id = sec.id "
-      "JOIN procedures p ON s.procedure_id = p.id "
-      "JOIN actions a ON s.action_id = a.id "
-      "JOIN specs sp ON s.spec_id = sp.id "
-      "WHERE c.name=? "
-      "ORDER BY sec.name, p.name, a.name;";
+  const std::string sql = std::string{kReadModelColumns} +
+                          "WHERE checklist=? ORDER BY section, procedure, action, address_id;";
 
   if (Prepare(db_, sql, &stmt) != SQLITE_OK) {
     Finalize(stmt);
@@ -720,21 +1154,66 @@ std::vector<ChecklistSlug> ChecklistStore::GetSlugsForChecklist(
   }
   sqlite3_bind_text(stmt, 1, checklist.c_str(), -1, SQLITE_TRANSIENT);
 
-  while (sqlite3_step(stmt) == SQLITE_ROW) {
+  while (NextRow(stmt, cancel, slugs.size())) {
     slugs.push_back(BuildSlug(stmt));
   }
   Finalize(stmt);
 
-  for (auto& slug : slugs) {
-    slug.relationships = LoadOutgoingEdges(slug.address_id);
+  for (std::size_t i = 0; i < slugs.size(); ++i) {
+    cancel.ThrowIfCancelled(i);
+    slugs[i].relationships = LoadOutgoingEdges(slugs[i].address_id);
   }
 
+  // Installed while mutex_ is still held, so no write can land between the load and the install.
+  slug_cache_->InstallChecklist(checklist, slugs);
+  return slugs;
+}
+
+std::vector<std::optional<ChecklistSlug>> ChecklistStore::GetSlugs(
+    const std::vector<std::string>& address_ids) const {
+  std::vector<std::optional<ChecklistSlug>> slugs(address_ids.size());
+  std::vector<std::size_t> misses;
+  for (std::size_t i = 0; i < address_ids.size(); ++i) {
+    slugs[i] = slug_cache_->GetSlug(address_ids[i]);
+    if (!slugs[i]) {
+      misses.push_back(i);
+    }
+  }
+  if (misses.empty()) {
+    return slugs;
+  }
+
+  ProfiledLock lock(mutex_, lock_profiler_, "GetSlugs");
+  sqlite3_stmt* stmt = nullptr;
+  const std::string sql = std::string{kReadModelColumns} + "WHERE address_id=?;";
+  if (Prepare(db_, sql, &stmt) != SQLITE_OK) {
+    Finalize(stmt);
+    throw std::runtime_error("Failed to prepare slug batch lookup");
+  }
+  ExecOrThrow(db_, "BEGIN;", "Begin transaction for slug batch lookup");
+  try {
+    for (const auto index : misses) {
+      sqlite3_bind_text(stmt, 1, address_ids[index].c_str(), -1, SQLITE_TRANSIENT);
+      if (sqlite3_step(stmt) == SQLITE_ROW) {
+        slugs[index] = BuildSlug(stmt);
+        slugs[index]->relationships = LoadOutgoingEdges(address_ids[index]);
+      }
+      sqlite3_reset(stmt);
+    }
+    Finalize(stmt);
+    stmt = nullptr;
+    ExecOrThrow(db_, "COMMIT;", "Commit slug batch lookup");
+  } catch (...) {
+    Finalize(stmt);
+    sqlite3_exec(db_, "ROLLBACK;", nullptr, nullptr, nullptr);
+    throw;
+  }
   return slugs;
 }
 
 RelationshipGraph ChecklistStore::GetRelationships(const std::string& address_id) const {
   RelationshipGraph graph;
-  std::lock_guard<std::mutex> lock(mutex_);
+  ProfiledLock lock(mutex_, lock_profiler_, "GetRelationships");
 
   sqlite3_stmt* outgoing_stmt = nullptr;
   if (Prepare(db_, "SELECT predicate, target_id FROM relationships WHERE subject_id=?;",
@@ -770,42 +1249,75 @@ RelationshipGraph ChecklistStore::GetRelationships(const std::string& address_id
 }
 
 void ChecklistStore::ApplyUpdate(const SlugUpdate& update) {
-  const ChecklistSlug existing = GetSlugOrThrow(update.address_id);
-  ChecklistSlug mutated = existing;
-
-  if (update.result) {
-    mutated.result = *update.result;
+  ProfiledLock lock(mutex_, lock_profiler_, "ApplyUpdate");
+  const WriteGenerationBump bump(write_generation_);
+  ExecOrThrow(db_, "BEGIN IMMEDIATE;", "Begin transaction for slug update");
+  try {
+    const ChecklistSlug state = ApplyUpdateUnlocked(update);
+    ExecOrThrow(db_, "COMMIT;", "Commit slug update");
+    slug_cache_->ApplyState(state);
+  } catch (...) {
+    sqlite3_exec(db_, "ROLLBACK;", nullptr, nullptr, nullptr);
+    throw;
   }
-  if (update.status) {
-    mutated.status = *update.status;
+}
+
+ChecklistSlug ChecklistStore::ApplyUpdateUnlocked(const SlugUpdate& update) {
+  ChecklistSlug mutated;
+  mutated.address_id = update.address_id;
+
+  sqlite3_stmt* stmt = nullptr;
+  if (Prepare(db_,
+              "SELECT result, status, comment, checklist, section, procedure "
+              "FROM slug_read_model WHERE address_id=?;",
+              &stmt) != SQLITE_OK) {
+    Finalize(stmt);
+    throw std::runtime_error("Failed to prepare slug state lookup");
   }
-  if (update.comment) {
-    mutated.comment = *update.comment;
+  sqlite3_bind_text(stmt, 1, update.address_id.c_str(), -1, SQLITE_TRANSIENT);
+  if (sqlite3_step(stmt) != SQLITE_ROW) {
+    Finalize(stmt);
+    throw std::runtime_error("Address ID not found: " + update.address_id);
   }
+  const ChecklistStatus previous_status = ParseStatus(ColumnText(stmt, 1));
+  mutated.result = update.result.value_or(ColumnText(stmt, 0));
+  mutated.status = update.status.value_or(previous_status);
+  mutated.comment = update.comment.value_or(ColumnText(stmt, 2));
   mutated.timestamp = update.timestamp.value_or(CurrentTimestampIsoUtc());
+  const std::string checklist = ColumnText(stmt, 3);
+  const std::string section = ColumnText(stmt, 4);
+  const std::string procedure = ColumnText(stmt, 5);
+  Finalize(stmt);
 
-  std::lock_guard<std::mutex> lock(mutex_);
-  sqlite3_stmt* stmt = nullptr;
-  const std::string sql =
-      "UPDATE slugs SET result=?, status=?, comment=?, timestamp=? WHERE address_id=?;";
-  if (Prepare(db_, sql, &stmt) != SQLITE_OK) {
+  const std::string status = StatusToString(mutated.status);
+  for (const char* sql :
+       {"UPDATE slugs SET result=?, status=?, comment=?, timestamp=? WHERE address_id=?;",
+        "UPDATE slug_read_model SET result=?, status=?, comment=?, timestamp=? "
+        "WHERE address_id=?;"}) {
+    stmt = nullptr;
+    if (Prepare(db_, sql, &stmt) != SQLITE_OK) {
+      Finalize(stmt);
+      throw std::runtime_error("Failed to prepare slug update");
+    }
+    sqlite3_bind_text(stmt, 1, mutated.result.c_str(), -1, SQLITE_TRANSIENT);
+    sqlite3_bind_text(stmt, 2, status.c_str(), -1, SQLITE_TRANSIENT);
+    sqlite3_bind_text(stmt, 3, mutated.comment.c_str(), -1, SQLITE_TRANSIENT);
+    sqlite3_bind_text(stmt, 4, mutated.timestamp.c_str(), -1, SQLITE_TRANSIENT);
+    sqlite3_bind_text(stmt, 5, mutated.address_id.c_str(), -1, SQLITE_TRANSIENT);
+    StepOrThrow(stmt, "slug update");
     Finalize(stmt);
-    throw std::runtime_error("Failed to prepare slug update");
   }
-
-  sqlite3_bind_text(stmt, 1, mutated.result.c_str(), -1, SQLITE_TRANSIENT);
-  sqlite3_bind_text(stmt, 2, StatusToString(mutated.status).c_str(), -1, SQLITE_TRANSIENT);
-  sqlite3_bind_text(stmt, 3, mutated.comment.c_str(), -1, SQLITE_TRANSIENT);
-  sqlite3_bind_text(stmt, 4, mutated.timestamp.c_str(), -1, SQLITE_TRANSIENT);
-  sqlite3_bind_text(stmt, 5, mutated.address_id.c_str(), -1, SQLITE_TRANSIENT);
-
-  StepOrThrow(stmt, "slug update");
-  Finalize(stmt);
+  if (mutated.status != previous_status) {
+    AdjustStatusRollup(checklist, section, procedure, previous_status, -1);
+    AdjustStatusRollup(checklist, section, procedure, mutated.status, 1);
+  }
   InsertHistorySnapshot(mutated);
+  return mutated;
 }
 
 void ChecklistStore::ReplaceChecklist(const std::string& checklist,
-                                      const std::vector<ChecklistSlug>& slugs) {
+                                      const std::vector<ChecklistSlug>& slugs,
+                                      const Cancellation& cancel) {
   if (checklist.empty()) {
     throw std::invalid_argument("Checklist name must not be empty.");
   }
@@ -815,7 +1327,11 @@ void ChecklistStore::ReplaceChecklist(const std::string& checklist,
     }
   }
 
-  std::lock_guard<std::mutex> lock(mutex_);
+  ProfiledLock lock(mutex_, lock_profiler_, "ReplaceChecklist");
+  const WriteGenerationBump bump(write_generation_);
+  // Deleting this checklist's slugs cascades to edges held by other checklists, so every cached
+  // checklist may be affected.
+  slug_cache_->Clear();
 
   char* errmsg = nullptr;
   sqlite3_exec(db_, "BEGIN IMMEDIATE;", nullptr, nullptr, &errmsg);
@@ -833,22 +1349,33 @@ void ChecklistStore::ReplaceChecklist(const std::string& checklist,
   sqlite3_stmt* insert_rel = nullptr;
 
   try {
-    const std::string slugs_sql =
-        "DELETE FROM slugs WHERE checklist_id IN (SELECT id FROM checklists WHERE name=?);";
-
-    if (Prepare(db_, slugs_sql, &delete_slugs) != SQLITE_OK) {
-      throw std::runtime_error("Failed to prepare checklist cleanup statements.");
-    }
+    // The search index has no foreign key to cascade through, so its rows go first; its
+    // slug_search_keys rows then cascade with the slugs.
+    const char* cleanup_sql[] = {
+        "DELETE FROM slug_search WHERE rowid IN (SELECT k.search_rowid FROM slug_search_keys k "
+        "JOIN slugs s ON s.address_id = k.address_id "
+        "JOIN checklists c ON s.checklist_id = c.id WHERE c.name=?);",
+        "DELETE FROM slugs WHERE checklist_id IN (SELECT id FROM checklists WHERE name=?);",
+        "DELETE FROM status_rollup WHERE checklist=?;",
+    };
+
+    for (const char* sql : cleanup_sql) {
+      if (Prepare(db_, sql, &delete_slugs) != SQLITE_OK) {
+        throw std::runtime_error("Failed to prepare checklist cleanup statements.");
+      }
 
-    sqlite3_bind_text(delete_slugs, 1, checklist.c_str(), -1, SQLITE_TRANSIENT);
-    StepOrThrow(delete_slugs, "slug delete");
+      sqlite3_bind_text(delete_slugs, 1, checklist.c_str(), -1, SQLITE_TRANSIENT);
+      StepOrThrow(delete_slugs, "slug delete");
 
-    Finalize(delete_slugs);
-    delete_slugs = nullptr;
+      Finalize(delete_slugs);
+      delete_slugs = nullptr;
+    }
 
     // Insert all slugs first to satisfy foreign keys, then batch relationships.
     std::vector<std::pair<std::string, RelationshipEdge>> pending_edges;
-    for (const auto& slug : slugs) {
+    for (std::size_t i = 0; i < slugs.size(); ++i) {
+      cancel.ThrowIfCancelled(i);
+      const auto& slug = slugs[i];
       UpsertSlugUnlocked(slug);
       for (const auto& edge : slug.relationships) {
         pending_edges.emplace_back(slug.address_id, edge);
@@ -882,28 +1409,167 @@ void ChecklistStore::ReplaceChecklist(const std::string& checklist,
   }
 }
 
-void ChecklistStore::ApplyBulkUpdates(const std::vector<SlugUpdate>& updates) {
+void ChecklistStore::ApplyBulkUpdates(const std::vector<SlugUpdate>& updates,
+                                      const Cancellation& cancel) {
   if (updates.empty()) {
     return;
   }
 
-  char* errmsg = nullptr;
-  sqlite3_exec(db_, "BEGIN IMMEDIATE;", nullptr, nullptr, &errmsg);
-  if (errmsg) {
-    std::string message = errmsg;
-    sqlite3_free(errmsg);
-    throw std::runtime_error("Failed to begin transaction for bulk update: " + message);
+  // The lock spans the whole transaction so no other call can interleave statements into it.
+  ProfiledLock lock(mutex_, lock_profiler_, "ApplyBulkUpdates");
+  const WriteGenerationBump bump(write_generation_);
+  ExecOrThrow(db_, "BEGIN IMMEDIATE;", "Begin transaction for bulk update");
+  try {
+    std::vector<ChecklistSlug> states;
+    states.reserve(updates.size());
+    for (const auto& update : updates) {
+      cancel.ThrowIfCancelled(states.size());
+      states.push_back(ApplyUpdateUnlocked(update));
+    }
+    ExecOrThrow(db_, "COMMIT;", "Commit bulk update");
+    for (const auto& state : states) {
+      slug_cache_->ApplyState(state);
+    }
+  } catch (...) {
+    sqlite3_exec(db_, "ROLLBACK;", nullptr, nullptr, nullptr);
+    throw;
   }
+}
 
+SlugImportResult ChecklistStore::ImportSlugs(const std::vector<ChecklistSlug>& slugs,
+                                             const Cancellation& cancel) {
+  SlugImportResult result;
+  if (slugs.empty()) {
+    return result;
+  }
+
+  ProfiledLock lock(mutex_, lock_profiler_, "ImportSlugs");
+  const WriteGenerationBump bump(write_generation_);
+  slug_cache_->Clear();
+  ExecOrThrow(db_, "BEGIN IMMEDIATE;", "Begin transaction for slug import");
+
+  sqlite3_stmt* exists_stmt = nullptr;
+  sqlite3_stmt* delete_rel = nullptr;
+  sqlite3_stmt* insert_rel = nullptr;
   try {
-    for (const auto& update : updates) {
-      ApplyUpdate(update);
+    // A savepoint per record keeps one bad row from discarding the rest of the batch.
+    std::vector<bool> imported(slugs.size(), false);
+    for (std::size_t i = 0; i < slugs.size(); ++i) {
+      cancel.ThrowIfCancelled(i);
+      ExecOrThrow(db_, "SAVEPOINT import_slug;", "Savepoint for slug import");
+      try {
+        UpsertSlugUnlocked(slugs[i]);
+        ExecOrThrow(db_, "RELEASE import_slug;", "Release slug import savepoint");
+        imported[i] = true;
+        ++result.upserted;
+      } catch (const std::exception& ex) {
+        sqlite3_exec(db_, "ROLLBACK TO import_slug; RELEASE import_slug;", nullptr, nullptr,
+                     nullptr);
+        result.failures.push_back({i, ex.what()});
+      }
     }
-    sqlite3_exec(db_, "COMMIT;", nullptr, nullptr, nullptr);
+
+    if (Prepare(db_, "SELECT 1 FROM slugs WHERE address_id=?;", &exists_stmt) != SQLITE_OK ||
+        Prepare(db_, "DELETE FROM relationships WHERE subject_id=?;", &delete_rel) !=
+            SQLITE_OK ||
+        Prepare(db_,
+                "INSERT INTO relationships (subject_id, predicate, target_id) VALUES (?,?,?);",
+                &insert_rel) != SQLITE_OK) {
+      throw std::runtime_error("Failed to prepare relationship statements for slug import.");
+    }
+
+    // Edges are written after every slug in the batch exists; targets still missing are
+    // handed back so the caller can retry them once later batches have landed.
+    for (std::size_t i = 0; i < slugs.size(); ++i) {
+      if (!imported[i]) {
+        continue;
+      }
+      const auto& subject = slugs[i].address_id;
+      sqlite3_reset(delete_rel);
+      sqlite3_bind_text(delete_rel, 1, subject.c_str(), -1, SQLITE_TRANSIENT);
+      StepOrThrow(delete_rel, "relationship delete");
+
+      for (const auto& edge : slugs[i].relationships) {
+        sqlite3_reset(exists_stmt);
+        sqlite3_bind_text(exists_stmt, 1, edge.target.c_str(), -1, SQLITE_TRANSIENT);
+        if (sqlite3_step(exists_stmt) != SQLITE_ROW) {
+          result.deferred.push_back({i, subject, edge});
+          continue;
+        }
+        sqlite3_reset(insert_rel);
+        sqlite3_bind_text(insert_rel, 1, subject.c_str(), -1, SQLITE_TRANSIENT);
+        sqlite3_bind_text(insert_rel, 2, edge.predicate.c_str(), -1, SQLITE_TRANSIENT);
+        sqlite3_bind_text(insert_rel, 3, edge.target.c_str(), -1, SQLITE_TRANSIENT);
+        StepOrThrow(insert_rel, "relationship insert");
+      }
+    }
+
+    Finalize(exists_stmt);
+    Finalize(delete_rel);
+    Finalize(insert_rel);
+    exists_stmt = delete_rel = insert_rel = nullptr;
+    ExecOrThrow(db_, "COMMIT;", "Commit slug import");
   } catch (...) {
+    Finalize(exists_stmt);
+    Finalize(delete_rel);
+    Finalize(insert_rel);
     sqlite3_exec(db_, "ROLLBACK;", nullptr, nullptr, nullptr);
     throw;
   }
+  return result;
+}
+
+std::vector<PendingRelationship> ChecklistStore::AddRelationships(
+    const std::vector<PendingRelationship>& edges) {
+  std::vector<PendingRelationship> unresolved;
+  if (edges.empty()) {
+    return unresolved;
+  }
+
+  ProfiledLock lock(mutex_, lock_profiler_, "AddRelationships");
+  const WriteGenerationBump bump(write_generation_);
+  slug_cache_->Clear();
+  ExecOrThrow(db_, "BEGIN IMMEDIATE;", "Begin transaction for relationship insert");
+
+  sqlite3_stmt* exists_stmt = nullptr;
+  sqlite3_stmt* insert_rel = nullptr;
+  try {
+    if (Prepare(db_, "SELECT 1 FROM slugs WHERE address_id=?;", &exists_stmt) != SQLITE_OK ||
+        Prepare(db_,
+                "INSERT INTO relationships (subject_id, predicate, target_id) VALUES (?,?,?);",
+                &insert_rel) != SQLITE_OK) {
+      throw std::runtime_error("Failed to prepare relationship insert.");
+    }
+
+    for (const auto& pending : edges) {
+      bool resolvable = true;
+      for (const auto* id : {&pending.subject_id, &pending.edge.target}) {
+        sqlite3_reset(exists_stmt);
+        sqlite3_bind_text(exists_stmt, 1, id->c_str(), -1, SQLITE_TRANSIENT);
+        resolvable = resolvable && sqlite3_step(exists_stmt) == SQLITE_ROW;
+      }
+      if (!resolvable) {
+        unresolved.push_back(pending);
+        continue;
+      }
+      sqlite3_reset(insert_rel);
+      sqlite3_bind_text(insert_rel, 1, pending.subject_id.c_str(), -1, SQLITE_TRANSIENT);
+      sqlite3_bind_text(insert_rel, 2, pending.edge.predicate.c_str(), -1, SQLITE_TRANSIENT);
+      sqlite3_bind_text(insert_rel, 3, pending.edge.target.c_str(), -1, SQLITE_TRANSIENT);
+      StepOrThrow(insert_rel, "relationship insert");
+    }
+
+    Finalize(exists_stmt);
+    Finalize(insert_rel);
+    exists_stmt = insert_rel = nullptr;
+    ExecOrThrow(db_, "COMMIT;", "Commit relationship insert");
+  } catch (...) {
+    Finalize(exists_stmt);
+    Finalize(insert_rel);
+    sqlite3_exec(db_, "ROLLBACK;", nullptr, nullptr, nullptr);
+    throw;
+  }
+  return unresolved;
 }
 
 void ChecklistStore::InsertHistorySnapshot(const ChecklistSlug& slug) {
@@ -926,6 +1592,166 @@ void ChecklistStore::InsertHistorySnapshot(const ChecklistSlug& slug) {
   Finalize(stmt);
 }
 
+std::vector<HistoryEntry> ChecklistStore::GetHistory(const std::string& address_id,
+                                                     const HistoryRange& range) const {
+  ProfiledLock lock(mutex_, lock_profiler_, "GetHistory");
+  sqlite3_stmt* stmt = nullptr;
+  if (Prepare(db_, "SELECT 1 FROM slug_read_model WHERE address_id=?;", &stmt) != SQLITE_OK) {
+    Finalize(stmt);
+    throw std::runtime_error("Failed to prepare slug existence check");
+  }
+  sqlite3_bind_text(stmt, 1, address_id.c_str(), -1, SQLITE_TRANSIENT);
+  const bool exists = sqlite3_step(stmt) == SQLITE_ROW;
+  Finalize(stmt);
+  if (!exists) {
+    throw std::runtime_error("Address ID not found: " + address_id);
+  }
+
+  std::string sql = "SELECT timestamp, result, status, comment FROM history WHERE address_id=?1";
+  if (!range.from.empty()) {
+    sql += " AND timestamp>=?2";
+  }
+  if (!range.to.empty()) {
+    sql += " AND timestamp<?3";
+  }
+  sql += " ORDER BY timestamp DESC LIMIT ?4;";
+  stmt = nullptr;
+  if (Prepare(db_, sql, &stmt) != SQLITE_OK) {
+    Finalize(stmt);
+    throw std::runtime_error("Failed to prepare history query");
+  }
+  sqlite3_bind_text(stmt, 1, address_id.c_str(), -1, SQLITE_TRANSIENT);
+  sqlite3_bind_text(stmt, 2, range.from.c_str(), -1, SQLITE_TRANSIENT);
+  sqlite3_bind_text(stmt, 3, range.to.c_str(), -1, SQLITE_TRANSIENT);
+  sqlite3_bind_int64(stmt, 4, static_cast<sqlite3_int64>(range.limit));
+
+  std::vector<HistoryEntry> entries;
+  while (sqlite3_step(stmt) == SQLITE_ROW) {
+    entries.push_back({ColumnText(stmt, 0), ColumnText(stmt, 1), ParseStatus(ColumnText(stmt, 2)),
+                       ColumnText(stmt, 3)});
+  }
+  Finalize(stmt);
+  return entries;
+}
+
+HistoryPruneBatch ChecklistStore::PruneHistory(const HistoryRetention& policy,
+                                               const std::string& after_address,
+                                               std::size_t max_addresses) {
+  HistoryPruneBatch batch;
+  if (!policy.Enabled() || max_addresses == 0) {
+    return batch;
+  }
+  const auto unix_seconds = [](std::chrono::system_clock::time_point when) {
+    return static_cast<sqlite3_int64>(
+        std::chrono::duration_cast<std::chrono::seconds>(when.time_since_epoch()).count());
+  };
+  const auto now = std::chrono::system_clock::now();
+  const auto age_cutoff = unix_seconds(now - policy.max_age);
+  const auto downsample_cutoff = unix_seconds(now - policy.downsample_after);
+  const auto bucket_seconds = std::max<int64_t>(policy.downsample_bucket.count(), 1);
+
+  // Every rule is scoped to one address so it runs as a range scan on the primary key.
+  // Timestamps are whatever the client sent, so rules compare them as Unix seconds rather than
+  // as text; rows SQLite cannot parse (strftime gives NULL) match no rule and are kept.
+  struct Rule {
+    bool enabled;
+    const char* sql;
+  };
+  const Rule rules[] = {
+      {policy.max_age.count() > 0,
+       "DELETE FROM history WHERE address_id=?1 AND "
+       "CAST(strftime('%s', timestamp) AS INTEGER)<?2;"},
+      {policy.max_per_address > 0,
+       "DELETE FROM history WHERE address_id=?1 AND "
+       "CAST(strftime('%s', timestamp) AS INTEGER)<("
+       "SELECT CAST(strftime('%s', timestamp) AS INTEGER) AS seconds FROM history "
+       "WHERE address_id=?1 AND seconds IS NOT NULL ORDER BY seconds DESC LIMIT 1 OFFSET ?3);"},
+      // Keeps the newest row of each bucket (SQLite takes the bare `timestamp` from the MAX row).
+      {policy.downsample_after.count() > 0,
+       "DELETE FROM history WHERE address_id=?1 AND "
+       "CAST(strftime('%s', timestamp) AS INTEGER)<?4 AND timestamp NOT IN ("
+       "SELECT timestamp FROM (SELECT timestamp, MAX(seconds) FROM ("
+       "SELECT timestamp, CAST(strftime('%s', timestamp) AS INTEGER) AS seconds FROM history "
+       "WHERE address_id=?1) WHERE seconds<?4 GROUP BY seconds / ?5));"},
+  };
+
+  ProfiledLock lock(mutex_, lock_profiler_, "PruneHistory");
+  const WriteGenerationBump bump(write_generation_);
+  std::vector<std::string> addresses;
+  sqlite3_stmt* stmt = nullptr;
+  if (Prepare(db_, "SELECT address_id FROM slugs WHERE address_id>? ORDER BY address_id LIMIT ?;",
+              &stmt) != SQLITE_OK) {
+    Finalize(stmt);
+    throw std::runtime_error("Failed to prepare history retention cursor");
+  }
+  sqlite3_bind_text(stmt, 1, after_address.c_str(), -1, SQLITE_TRANSIENT);
+  sqlite3_bind_int64(stmt, 2, static_cast<sqlite3_int64>(max_addresses));
+  while (sqlite3_step(stmt) == SQLITE_ROW) {
+    addresses.push_back(ColumnText(stmt, 0));
+  }
+  Finalize(stmt);
+  if (addresses.empty()) {
+    return batch;
+  }
+
+  ExecOrThrow(db_, "BEGIN IMMEDIATE;", "Begin transaction for history retention");
+  std::vector<sqlite3_stmt*> statements;
+  try {
+    for (const auto& rule : rules) {
+      if (!rule.enabled) {
+        continue;
+      }
+      sqlite3_stmt* rule_stmt = nullptr;
+      if (Prepare(db_, rule.sql, &rule_stmt) != SQLITE_OK) {
+        Finalize(rule_stmt);
+        throw std::runtime_error("Failed to prepare history retention rule");
+      }
+      statements.push_back(rule_stmt);
+    }
+    for (const auto& address : addresses) {
+      for (auto* rule_stmt : statements) {
+        sqlite3_reset(rule_stmt);
+        // Each rule references only some of ?1..?5; bind just those and check every result.
+        const auto bind_text = [rule_stmt](const char* name, const std::string& value) {
+          if (const int index = sqlite3_bind_parameter_index(rule_stmt, name); index > 0) {
+            BindOrThrow(sqlite3_bind_text(rule_stmt, index, value.c_str(), -1, SQLITE_TRANSIENT),
+                        "history retention");
+          }
+        };
+        const auto bind_int64 = [rule_stmt](const char* name, sqlite3_int64 value) {
+          if (const int index = sqlite3_bind_parameter_index(rule_stmt, name); index > 0) {
+            BindOrThrow(sqlite3_bind_int64(rule_stmt, index, value), "history retention");
+          }
+        };
+        bind_text("?1", address);
+        bind_int64("?2", age_cutoff);
+        bind_int64("?3", std::max(policy.max_per_address, 1) - 1);
+        bind_int64("?4", downsample_cutoff);
+        bind_int64("?5", bucket_seconds);
+        StepOrThrow(rule_stmt, "history retention");
+        batch.rows_deleted += sqlite3_changes(db_);
+      }
+    }
+    for (auto* rule_stmt : statements) {
+      Finalize(rule_stmt);
+    }
+    statements.clear();
+    ExecOrThrow(db_, "COMMIT;", "Commit history retention");
+  } catch (...) {
+    for (auto* rule_stmt : statements) {
+      Finalize(rule_stmt);
+    }
+    sqlite3_exec(db_, "ROLLBACK;", nullptr, nullptr, nullptr);
+    throw;
+  }
+
+  batch.addresses = addresses.size();
+  if (addresses.size() == max_addresses) {
+    batch.next_address = addresses.back();
+  }
+  return batch;
+}
+
 std::vector<RelationshipEdge> ChecklistStore::LoadOutgoingEdges(
     const std::string& address_id) const {
   std::vector<RelationshipEdge> edges;
@@ -947,40 +1773,393 @@ std::vector<RelationshipEdge> ChecklistStore::LoadOutgoingEdges(
   return edges;
 }
 
-std::vector<ChecklistSlug> ChecklistStore::ExportAllSlugs() const {
+std::vector<ChecklistSlug> ChecklistStore::ExportAllSlugs(const Cancellation& cancel) const {
+  if (auto cached = slug_cache_->ExportAll()) {
+    return std::move(*cached);
+  }
+  ProfiledLock lock(mutex_, lock_profiler_, "ExportAllSlugs");
+  auto slugs = ExportAllSlugsUnlocked(cancel);
+  slug_cache_->InstallAll(slugs);
+  return slugs;
+}
+
+std::vector<ChecklistSlug> ChecklistStore::ExportAllSlugsUnlocked(
+    const Cancellation& cancel) const {
   std::vector<ChecklistSlug> slugs;
-  std::lock_guard<std::mutex> lock(mutex_);
   sqlite3_stmt* stmt = nullptr;
   const std::string sql =
-      "SELECT s.address_id, c.name, sec.name, p.name, a.name, sp.text, s.result, s.status, "
-      "s.comment, s.timestamp, s.instructions "
-      "FROM slugs s "
-      "JOIN checklists c ON s.checklist_id = c.id "
-      "JOIN sections sec ON s.section_id = sec.id "
-      "JOIN procedures p ON s.procedure_id = p.id "
-      "JOIN actions a ON s.action_id = a.id "
-      "JOIN specs sp ON s.spec_id = sp.id "
-      "ORDER BY c.name, sec.name, p.name, a.name;";
+      std::string{kReadModelColumns} +
+      "ORDER BY checklist, section, procedure, action, address_id;";
 
   if (Prepare(db_, sql, &stmt) != SQLITE_OK) {
     Finalize(stmt);
     throw std::runtime_error("Failed to prepare export query");
   }
 
-  while (sqlite3_step(stmt) == SQLITE_ROW) {
+  std::unordered_map<std::string, std::size_t> positions;
+  while (NextRow(stmt, cancel, slugs.size())) {
     slugs.push_back(BuildSlug(stmt));
+    positions.emplace(slugs.back().address_id, slugs.size() - 1);
   }
   Finalize(stmt);
 
-  for (auto& slug : slugs) {
-    slug.relationships = LoadOutgoingEdges(slug.address_id);
+  // One pass over the edge table instead of a lookup per slug; rowid keeps insertion order.
+  stmt = nullptr;
+  if (Prepare(db_, "SELECT subject_id, predicate, target_id FROM relationships ORDER BY rowid;",
+              &stmt) != SQLITE_OK) {
+    Finalize(stmt);
+    throw std::runtime_error("Failed to prepare relationship export query");
+  }
+  for (std::size_t row = 0; NextRow(stmt, cancel, row); ++row) {
+    const auto it = positions.find(ColumnText(stmt, 0));
+    if (it != positions.end()) {
+      slugs[it->second].relationships.push_back({ColumnText(stmt, 1), ColumnText(stmt, 2)});
+    }
   }
+  Finalize(stmt);
   return slugs;
 }
 
+SlugPage ChecklistStore::QuerySlugs(const SlugQuery& query, const Cancellation& cancel) const {
+  // Projected-out columns are selected as constants so BuildSlug's column layout still holds.
+  struct Column {
+    SlugField field;
+    const char* name;
+  };
+  static constexpr Column kColumns[] = {
+      {kSlugFieldChecklist, "checklist"}, {kSlugFieldSection, "section"},
+      {kSlugFieldProcedure, "procedure"}, {kSlugFieldAction, "action"},
+      {kSlugFieldSpec, "spec"},           {kSlugFieldResult, "result"},
+      {kSlugFieldStatus, "status"},       {kSlugFieldComment, "comment"},
+      {kSlugFieldTimestamp, "timestamp"}, {kSlugFieldInstructions, "instructions"},
+  };
+  std::string sql = "SELECT address_id";
+  for (const auto& column : kColumns) {
+    sql += (query.fields & column.field) ? std::string{", "} + column.name : ", ''";
+  }
+  // The sort key follows unprojected, for the next page's cursor.
+  sql += ", checklist, section, procedure, action FROM slug_read_model WHERE 1";
+  if (!query.checklist.empty()) {
+    sql += " AND checklist=?";
+  }
+  if (!query.statuses.empty()) {
+    sql += " AND status IN (?";
+    for (std::size_t i = 1; i < query.statuses.size(); ++i) {
+      sql += ", ?";
+    }
+    sql += ")";
+  }
+  if (!query.after.empty()) {
+    // With the checklist pinned, leaving it out of the row value lets the index seek directly.
+    sql += query.checklist.empty()
+               ? " AND (checklist, section, procedure, action, address_id) > (?, ?, ?, ?, ?)"
+               : " AND (section, procedure, action, address_id) > (?, ?, ?, ?)";
+  }
+  sql += " ORDER BY checklist, section, procedure, action, address_id";
+  if (query.limit > 0) {
+    sql += " LIMIT ?";  // one extra row tells whether another page follows
+  }
+  sql += ";";
+
+  SlugPage page;
+  ProfiledLock lock(mutex_, lock_profiler_, "QuerySlugs");
+  std::vector<std::string> cursor;
+  sqlite3_stmt* stmt = nullptr;
+  if (const auto position = DecodeSlugCursor(query.after)) {
+    if (!query.checklist.empty() && position->checklist != query.checklist) {
+      throw std::invalid_argument("Cursor belongs to another checklist: " + query.after);
+    }
+    cursor = {position->checklist, position->section, position->procedure, position->action,
+              position->address_id};
+  } else if (!query.after.empty()) {
+    // A bare address_id (e.g. from MCP output whose projection dropped the sort key) is resolved
+    // to its position, so it only works while that slug exists.
+    if (Prepare(db_,
+                "SELECT checklist, section, procedure, action FROM slug_read_model "
+                "WHERE address_id=?;",
+                &stmt) != SQLITE_OK) {
+      Finalize(stmt);
+      throw std::runtime_error("Failed to prepare cursor lookup");
+    }
+    sqlite3_bind_text(stmt, 1, query.after.c_str(), -1, SQLITE_TRANSIENT);
+    if (sqlite3_step(stmt) == SQLITE_ROW) {
+      for (int i = 0; i < 4; ++i) {
+        cursor.push_back(ColumnText(stmt, i));
+      }
+    }
+    Finalize(stmt);
+    if (cursor.empty() || (!query.checklist.empty() && cursor.front() != query.checklist)) {
+      throw std::invalid_argument("Unknown cursor: " + query.after);
+    }
+    cursor.push_back(query.after);
+  }
+  if (!cursor.empty() && !query.checklist.empty()) {
+    cursor.erase(cursor.begin());
+  }
+
+  stmt = nullptr;
+  if (Prepare(db_, sql, &stmt) != SQLITE_OK) {
+    Finalize(stmt);
+    throw std::runtime_error("Failed to prepare slug query");
+  }
+  int index = 0;
+  if (!query.checklist.empty()) {
+    sqlite3_bind_text(stmt, ++index, query.checklist.c_str(), -1, SQLITE_TRANSIENT);
+  }
+  for (const auto status : query.statuses) {
+    sqlite3_bind_text(stmt, ++index, StatusToString(status).c_str(), -1, SQLITE_TRANSIENT);
+  }
+  for (const auto& value : cursor) {
+    sqlite3_bind_text(stmt, ++index, value.c_str(), -1, SQLITE_TRANSIENT);
+  }
+  if (query.limit > 0) {
+    sqlite3_bind_int64(stmt, ++index, static_cast<sqlite3_int64>(query.limit) + 1);
+  }
+  SlugCursor last_kept;
+  while (NextRow(stmt, cancel, page.slugs.size())) {
+    if (page.slugs.size() + 1 == query.limit) {
+      last_kept = {ColumnText(stmt, 11), ColumnText(stmt, 12), ColumnText(stmt, 13),
+                   ColumnText(stmt, 14), ColumnText(stmt, 0)};
+    }
+    page.slugs.push_back(BuildSlug(stmt));
+  }
+  Finalize(stmt);
+
+  if (query.limit > 0 && page.slugs.size() > query.limit) {
+    page.slugs.pop_back();
+    page.next_cursor = EncodeSlugCursor(last_kept);
+  }
+  if (query.fields & kSlugFieldRelationships) {
+    for (std::size_t i = 0; i < page.slugs.size(); ++i) {
+      cancel.ThrowIfCancelled(i);
+      page.slugs[i].relationships = LoadOutgoingEdges(page.slugs[i].address_id);
+    }
+  }
+  return page;
+}
+
+std::vector<SearchHit> ChecklistStore::Search(const SearchQuery& query) const {
+  // Column weights follow the FTS5 column order: address_id, checklist (unindexed), action, spec,
+  // instructions. A hit in the short action text says far more than one in long instructions.
+  static constexpr const char* kRank = "bm25(slug_search, 0.0, 0.0, 10.0, 5.0, 1.0)";
+  const std::string match = BuildFtsQuery(query.text);
+  std::string sql =
+      std::string{"SELECT m.address_id, m.checklist, m.section, m.procedure, m.action, m.spec, "
+                  "'', m.status, '', '', '', -"} +
+      kRank + ", snippet(slug_search, -1, '[', ']', '...', 12) FROM slug_search "
+      "JOIN slug_read_model m ON m.address_id = slug_search.address_id "
+      "WHERE slug_search MATCH ?";
+  if (!query.checklists.empty()) {
+    sql += " AND slug_search.checklist IN (?";
+    for (std::size_t i = 1; i < query.checklists.size(); ++i) {
+      sql += ", ?";
+    }
+    sql += ")";
+  }
+  sql += std::string{" ORDER BY "} + kRank + " LIMIT ?;";
+
+  std::vector<SearchHit> hits;
+  ProfiledLock lock(mutex_, lock_profiler_, "Search");
+  sqlite3_stmt* stmt = nullptr;
+  if (Prepare(db_, sql, &stmt) != SQLITE_OK) {
+    Finalize(stmt);
+    throw std::runtime_error("Failed to prepare search query");
+  }
+  int index = 0;
+  sqlite3_bind_text(stmt, ++index, match.c_str(), -1, SQLITE_TRANSIENT);
+  for (const auto& checklist : query.checklists) {
+    sqlite3_bind_text(stmt, ++index, checklist.c_str(), -1, SQLITE_TRANSIENT);
+  }
+  sqlite3_bind_int64(stmt, ++index, static_cast<sqlite3_int64>(query.limit));
+  int rc = SQLITE_ROW;
+  while ((rc = sqlite3_step(stmt)) == SQLITE_ROW) {
+    SearchHit hit;
+    hit.slug = BuildSlug(stmt);
+    hit.score = sqlite3_column_double(stmt, 11);
+    hit.snippet = ColumnText(stmt, 12);
+    hits.push_back(std::move(hit));
+  }
+  Finalize(stmt);
+  if (rc != SQLITE_DONE) {
+    throw std::runtime_error("Search query failed: " + std::string{sqlite3_errmsg(db_)});
+  }
+  return hits;
+}
+
+LockProfile ChecklistStore::LockContention() const { return lock_profiler_.Snapshot(); }
+
+WarmUpResult ChecklistStore::WarmUp(std::chrono::milliseconds budget) {
+  WarmUpResult result;
+  const auto started = std::chrono::steady_clock::now();
+  const auto deadline = started + budget;
+  auto expired = [&]() { return std::chrono::steady_clock::now() >= deadline; };
+
+  // Sequential reads are the cheapest way to fault the file into the OS cache; SQLite's own
+  // cache is then filled by the queries below.
+  if (!db_path_.empty() && db_path_ != ":memory:") {
+    std::ifstream file(db_path_, std::ios::binary);
+    std::vector<char> buffer(1 << 20);
+    while (file && !expired()) {
+      file.read(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+      result.bytes_read += file.gcount();
+    }
+    result.complete = !file || file.eof();
+  }
+
+  const char* kHotQueries[] = {
+      "SELECT address_id, checklist, section, procedure, action, spec, result, status, "
+      "instructions FROM slug_read_model ORDER BY checklist, section, procedure, action;",
+      "SELECT subject_id, predicate, target_id FROM relationships INDEXED BY "
+      "idx_relationships_subject ORDER BY subject_id;",
+      "SELECT subject_id FROM relationships INDEXED BY idx_relationships_target "
+      "ORDER BY target_id;",
+  };
+
+  ProfiledLock lock(mutex_, lock_profiler_, "WarmUp");
+  for (const char* sql : kHotQueries) {
+    if (!result.complete) {
+      break;
+    }
+    sqlite3_stmt* stmt = nullptr;
+    if (Prepare(db_, sql, &stmt) != SQLITE_OK) {
+      Finalize(stmt);
+      throw std::runtime_error("Failed to prepare warm-up query");
+    }
+    while (sqlite3_step(stmt) == SQLITE_ROW) {
+      if ((++result.rows_visited & 0x3FF) == 0 && expired()) {
+        result.complete = false;
+        break;
+      }
+    }
+    Finalize(stmt);
+  }
+  if (result.complete && !expired()) {
+    slug_cache_->InstallAll(ExportAllSlugsUnlocked());
+  }
+
+  result.duration = std::chrono::duration_cast<std::chrono::milliseconds>(
+      std::chrono::steady_clock::now() - started);
+  LogInfo("Warm-up read " + std::to_string(result.bytes_read) + " bytes and " +
+          std::to_string(result.rows_visited) + " rows in " +
+          std::to_string(result.duration.count()) + " ms" +
+          (result.complete ? "" : " (budget exhausted)"));
+  return result;
+}
+
+SnapshotResult ChecklistStore::Snapshot(const std::string& destination,
+                                        const SnapshotOptions& options) const {
+  namespace fs = std::filesystem;
+  std::unique_lock<std::mutex> snapshot_lock(snapshot_mutex_, std::try_to_lock);
+  if (!snapshot_lock.owns_lock()) {
+    throw SnapshotBusyError("A snapshot is already in progress.");
+  }
+  if (!db_) {
+    throw std::runtime_error("Store is not initialized.");
+  }
+
+  const auto started = std::chrono::steady_clock::now();
+  const fs::path target(destination);
+  if (target.has_parent_path()) {
+    fs::create_directories(target.parent_path());
+  }
+  const fs::path partial = target.string() + ".partial";
+  std::error_code ec;
+  fs::remove(partial, ec);
+
+  // An in-memory database is only reachable through db_, so it is copied under the store lock in
+  // one pass; file databases get a private read connection and never touch mutex_.
+  const bool in_memory = db_path_.empty() || db_path_ == ":memory:";
+  std::optional<ProfiledLock> store_lock;
+  sqlite3* source = nullptr;
+  sqlite3* dest = nullptr;
+  sqlite3_backup* backup = nullptr;
+
+  auto close_all = [&]() {
+    if (backup) {
+      sqlite3_backup_finish(backup);
+      backup = nullptr;
+    }
+    if (dest) {
+      sqlite3_close(dest);
+      dest = nullptr;
+    }
+    if (source && source != db_) {
+      sqlite3_exec(source, "ROLLBACK;", nullptr, nullptr, nullptr);
+      sqlite3_close(source);
+    }
+    source = nullptr;
+  };
+
+  SnapshotResult result;
+  result.path = target.string();
+  try {
+    if (in_memory) {
+      store_lock.emplace(mutex_, lock_profiler_, "Snapshot");
+      source = db_;
+    } else {
+      const int rc = sqlite3_open_v2(db_path_.c_str(), &source, SQLITE_OPEN_READONLY, nullptr);
+      if (rc != SQLITE_OK) {
+        throw std::runtime_error("Failed to open snapshot source: " +
+                                 std::string(sqlite3_errstr(rc)));
+      }
+      // Holding a read transaction pins the WAL snapshot, so concurrent commits neither block
+      // the copy nor force the backup to restart.
+      ExecOrThrow(source, "BEGIN; SELECT COUNT(*) FROM sqlite_master;",
+                  "Snapshot read transaction");
+    }
+
+    const int open_rc = sqlite3_open_v2(partial.string().c_str(), &dest,
+                                        SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE, nullptr);
+    if (open_rc != SQLITE_OK) {
+      throw std::runtime_error("Failed to create snapshot file " + partial.string() + ": " +
+                               sqlite3_errstr(open_rc));
+    }
+    backup = sqlite3_backup_init(dest, "main", source, "main");
+    if (!backup) {
+      throw std::runtime_error("Failed to start backup: " + std::string(sqlite3_errmsg(dest)));
+    }
+
+    const int pages_per_step = in_memory ? -1 : std::max(1, options.pages_per_step);
+    while (true) {
+      const int rc = sqlite3_backup_step(backup, pages_per_step);
+      ++result.steps;
+      if (rc == SQLITE_DONE) {
+        break;
+      }
+      if (rc != SQLITE_OK && rc != SQLITE_BUSY && rc != SQLITE_LOCKED) {
+        throw std::runtime_error("Backup step failed: " + std::string(sqlite3_errstr(rc)));
+      }
+      if (options.step_pause.count() > 0) {
+        std::this_thread::sleep_for(options.step_pause);
+      }
+    }
+    result.pages = sqlite3_backup_pagecount(backup);
+    const int finish_rc = sqlite3_backup_finish(backup);
+    backup = nullptr;
+    if (finish_rc != SQLITE_OK) {
+      throw std::runtime_error("Backup finish failed: " + std::string(sqlite3_errstr(finish_rc)));
+    }
+    close_all();
+    store_lock.reset();
+
+    fs::rename(partial, target);
+  } catch (...) {
+    close_all();
+    fs::remove(partial, ec);
+    throw;
+  }
+
+  result.bytes = static_cast<std::int64_t>(fs::file_size(target, ec));
+  result.duration = std::chrono::duration_cast<std::chrono::milliseconds>(
+      std::chrono::steady_clock::now() - started);
+  LogInfo("Snapshot written to " + result.path + " (" + std::to_string(result.pages) +
+          " pages in " + std::to_string(result.steps) + " steps)");
+  return result;
+}
+
 std::vector<std::string> ChecklistStore::ListChecklists() const {
   std::vector<std::string> names;
-  std::lock_guard<std::mutex> lock(mutex_);
+  ProfiledLock lock(mutex_, lock_profiler_, "ListChecklists");
   sqlite3_stmt* stmt = nullptr;
   if (Prepare(db_, "SELECT name FROM checklists ORDER BY name;", &stmt) !=
       SQLITE_OK) {
@@ -995,5 +2174,50 @@ std::vector<std::string> ChecklistStore::ListChecklists() const {
   return names;
 }
 
+std::int64_t StatusRollup::Total() const {
+  std::int64_t total = 0;
+  for (const auto count : counts) {
+    total += count;
+  }
+  return total;
+}
+
+std::vector<StatusRollup> ChecklistStore::GetStatusRollup(RollupLevel level,
+                                                          const std::string& checklist) const {
+  std::string sql =
+      "SELECT checklist, section, procedure, status, count FROM status_rollup "
+      "WHERE level=? AND count<>0";
+  if (!checklist.empty()) {
+    sql += " AND checklist=?";
+  }
+  sql += " ORDER BY checklist, section, procedure;";
+
+  std::vector<StatusRollup> nodes;
+  ProfiledLock lock(mutex_, lock_profiler_, "GetStatusRollup");
+  sqlite3_stmt* stmt = nullptr;
+  if (Prepare(db_, sql, &stmt) != SQLITE_OK) {
+    Finalize(stmt);
+    throw std::runtime_error("Failed to prepare status roll-up query");
+  }
+  sqlite3_bind_int(stmt, 1, static_cast<int>(level));
+  if (!checklist.empty()) {
+    sqlite3_bind_text(stmt, 2, checklist.c_str(), -1, SQLITE_TRANSIENT);
+  }
+  // Rows arrive grouped by node, one per status present.
+  while (sqlite3_step(stmt) == SQLITE_ROW) {
+    std::string node_checklist = ColumnText(stmt, 0);
+    std::string section = ColumnText(stmt, 1);
+    std::string procedure = ColumnText(stmt, 2);
+    if (nodes.empty() || nodes.back().checklist != node_checklist ||
+        nodes.back().section != section || nodes.back().procedure != procedure) {
+      nodes.push_back({std::move(node_checklist), std::move(section), std::move(procedure), {}});
+    }
+    const auto status = ParseStatus(ColumnText(stmt, 3));
+    nodes.back().counts[static_cast<std::size_t>(status)] += sqlite3_column_int64(stmt, 4);
+  }
+  Finalize(stmt);
+  return nodes;
+}
+
 }  // namespace core
 
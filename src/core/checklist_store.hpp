@@ -1,10 +1,21 @@
 #pragma once
 
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
 #include <optional>
+#include <stdexcept>
 #include <string>
 #include <vector>
 #include <mutex>
 
+#include "core/lock_profiler.hpp"
+#include "core/storage_settings.hpp"
+#include "core/wal_checkpointer.hpp"
+
 struct sqlite3;
 
 namespace core {
@@ -46,9 +57,192 @@ struct SlugUpdate {
   std::optional<std::string> timestamp;
 };
 
+// A relationship whose endpoints may not exist yet. `index` is caller-defined (the position of
+// the originating record), so unresolved edges can be reported against their source.
+struct PendingRelationship {
+  std::size_t index = 0;
+  std::string subject_id;
+  RelationshipEdge edge;
+};
+
+struct SlugImportFailure {
+  std::size_t index = 0;
+  std::string error;
+};
+
+struct SlugImportResult {
+  std::size_t upserted = 0;
+  std::vector<SlugImportFailure> failures;
+  std::vector<PendingRelationship> deferred;  // targets not present in the store yet
+};
+
+struct SnapshotOptions {
+  int pages_per_step = 256;
+  std::chrono::milliseconds step_pause{5};  // writers run freely while the copier sleeps
+};
+
+struct SnapshotResult {
+  std::string path;
+  std::int64_t pages = 0;
+  std::int64_t bytes = 0;
+  int steps = 0;
+  std::chrono::milliseconds duration{0};
+};
+
+struct WarmUpResult {
+  std::int64_t bytes_read = 0;    // database file pulled through the OS page cache
+  std::int64_t rows_visited = 0;  // rows walked on the hot read queries
+  bool complete = true;           // false when the budget ran out first
+  std::chrono::milliseconds duration{0};
+};
+
+struct HistoryEntry {
+  std::string timestamp;
+  std::string result;
+  ChecklistStatus status = ChecklistStatus::kUnknown;
+  std::string comment;
+};
+
+// Newest-first window over one slug's history. `from` is inclusive, `to` exclusive; empty bounds
+// are open. Timestamps compare as ISO-8601 strings.
+struct HistoryRange {
+  std::string from;
+  std::string to;
+  std::size_t limit = 100;
+};
+
+struct HistoryRetention {
+  std::chrono::seconds max_age{0};           // drop entries older than this; 0 keeps all
+  int max_per_address = 0;                   // keep only the newest N per slug; 0 is unlimited
+  std::chrono::seconds downsample_after{0};  // past this age keep the last entry per bucket
+  std::chrono::seconds downsample_bucket{3600};
+
+  bool Enabled() const {
+    return max_age.count() > 0 || max_per_address > 0 || downsample_after.count() > 0;
+  }
+};
+
+struct HistoryPruneBatch {
+  std::size_t addresses = 0;
+  std::int64_t rows_deleted = 0;
+  std::string next_address;  // resume point; empty once the pass has reached the last slug
+};
+
+// Columns a slug listing returns (bitmask); the others come back empty. address_id is always
+// returned.
+enum SlugField : std::uint32_t {
+  kSlugFieldChecklist = 1u << 0,
+  kSlugFieldSection = 1u << 1,
+  kSlugFieldProcedure = 1u << 2,
+  kSlugFieldAction = 1u << 3,
+  kSlugFieldSpec = 1u << 4,
+  kSlugFieldResult = 1u << 5,
+  kSlugFieldStatus = 1u << 6,
+  kSlugFieldComment = 1u << 7,
+  kSlugFieldTimestamp = 1u << 8,
+  kSlugFieldInstructions = 1u << 9,
+  kSlugFieldRelationships = 1u << 10,
+  kAllSlugFields = (1u << 11) - 1,
+};
+
+// A filtered, projected page of slugs in (checklist, section, procedure, action, address_id)
+// order. Pages are keyset-based: pass the previous page's `next_cursor` as `after`. The cursor
+// encodes that page's last sort key (see SlugCursor), so the next page continues after it even if
+// the slug has since been deleted.
+struct SlugQuery {
+  std::string checklist;                  // empty spans every checklist
+  std::vector<ChecklistStatus> statuses;  // empty matches any status
+  std::string after;  // a next_cursor, or a bare address_id while that slug exists
+  std::size_t limit = 0;  // 0 returns every match
+  std::uint32_t fields = kAllSlugFields;
+};
+
+struct SlugPage {
+  std::vector<ChecklistSlug> slugs;
+  std::string next_cursor;  // empty on the last page
+};
+
+// `text` is plain words, all required; the last one also matches as a prefix.
+struct SearchQuery {
+  std::string text;
+  std::vector<std::string> checklists;  // empty searches every checklist
+  std::size_t limit = 20;
+};
+
+struct SearchHit {
+  ChecklistSlug slug;   // template fields and status only
+  double score = 0;     // negated BM25; higher is more relevant
+  std::string snippet;  // best-matching fragment with hits wrapped in [ ]
+};
+
+enum class RollupLevel { kChecklist = 0, kSection, kProcedure };
+
+// Maintained slug counts for one hierarchy node; names below the node's level are empty.
+struct StatusRollup {
+  std::string checklist;
+  std::string section;
+  std::string procedure;
+  std::array<std::int64_t, 5> counts{};  // indexed by ChecklistStatus
+
+  std::int64_t Count(ChecklistStatus status) const {
+    return counts[static_cast<std::size_t>(status)];
+  }
+  std::int64_t Total() const;
+};
+
+struct SlugCacheStats {
+  bool enabled = false;
+  bool complete = false;  // every checklist is resident
+  std::size_t checklists = 0;
+  std::size_t slugs = 0;
+  std::size_t relationships = 0;
+  std::size_t interned_strings = 0;
+  std::size_t approx_bytes = 0;
+  std::uint64_t hits = 0;
+  std::uint64_t misses = 0;
+};
+
+class SlugCache;
+
+// Thrown by Snapshot when another snapshot is still copying.
+class SnapshotBusyError : public std::runtime_error {
+ public:
+  using std::runtime_error::runtime_error;
+};
+
+// Thrown by a store operation whose Cancellation fired; any transaction it opened is rolled back.
+class OperationCancelled : public std::runtime_error {
+ public:
+  OperationCancelled(const std::string& what, bool deadline_exceeded)
+      : std::runtime_error(what), deadline_exceeded_(deadline_exceeded) {}
+
+  bool deadline_exceeded() const { return deadline_exceeded_; }
+
+ private:
+  bool deadline_exceeded_;
+};
+
+// Lets a caller abandon a long store operation. It is checked once the store lock is held and
+// then every kCancelCheckRows rows, so abandoned work gives up the lock within one batch.
+struct Cancellation {
+  static constexpr std::size_t kCancelCheckRows = 256;
+
+  std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::time_point::max();
+  std::function<bool()> abandoned;  // e.g. the requesting client disconnected
+
+  // Throws OperationCancelled once the deadline has passed or the caller is gone.
+  void ThrowIfCancelled() const;
+  // Checks only at batch boundaries: when `row` is a multiple of kCancelCheckRows.
+  void ThrowIfCancelled(std::size_t row) const {
+    if (row % kCancelCheckRows == 0) {
+      ThrowIfCancelled();
+    }
+  }
+};
+
 class ChecklistStore {
  public:
-  explicit ChecklistStore(std::string db_path);
+  explicit ChecklistStore(std::string db_path, StorageSettings storage = {});
   ~ChecklistStore();
 
   ChecklistStore(const ChecklistStore&) = delete;
@@ -56,28 +250,99 @@ class ChecklistStore {
 
   void Initialize(bool seed_demo_data);
   ChecklistSlug GetSlugOrThrow(const std::string& address_id) const;
-  std::vector<ChecklistSlug> GetSlugsForChecklist(const std::string& checklist) const;
+  std::vector<ChecklistSlug> GetSlugsForChecklist(const std::string& checklist,
+                                                  const Cancellation& cancel = {}) const;
+  // Looks up many slugs at once; the result is aligned with `address_ids` and holds nullopt for
+  // ids that name no slug. Cache misses are read together in one transaction.
+  std::vector<std::optional<ChecklistSlug>> GetSlugs(
+      const std::vector<std::string>& address_ids) const;
   RelationshipGraph GetRelationships(const std::string& address_id) const;
   void ApplyUpdate(const SlugUpdate& update);
-  void ApplyBulkUpdates(const std::vector<SlugUpdate>& updates);
-  void ReplaceChecklist(const std::string& checklist, const std::vector<ChecklistSlug>& slugs);
-  std::vector<ChecklistSlug> ExportAllSlugs() const;
+  void ApplyBulkUpdates(const std::vector<SlugUpdate>& updates, const Cancellation& cancel = {});
+  void ReplaceChecklist(const std::string& checklist, const std::vector<ChecklistSlug>& slugs,
+                        const Cancellation& cancel = {});
+  // Upserts slugs from any checklists in one transaction. Each record's outgoing relationships
+  // are replaced; a record that fails is rolled back alone and reported by index.
+  SlugImportResult ImportSlugs(const std::vector<ChecklistSlug>& slugs,
+                               const Cancellation& cancel = {});
+  // Inserts the edges whose endpoints now exist and returns the ones that still do not.
+  std::vector<PendingRelationship> AddRelationships(const std::vector<PendingRelationship>& edges);
+  std::vector<ChecklistSlug> ExportAllSlugs(const Cancellation& cancel = {}) const;
+  // Runs the filter, projection and keyset in SQL against the read model; bypasses the slug
+  // cache. Throws std::invalid_argument when `after` names no slug.
+  SlugPage QuerySlugs(const SlugQuery& query, const Cancellation& cancel = {}) const;
+  // Ranks slugs by action, spec and instruction text through the FTS5 index. Throws
+  // std::invalid_argument when `text` has no words.
+  std::vector<SearchHit> Search(const SearchQuery& query) const;
   std::vector<std::string> ListChecklists() const;
+  // Reads the status_rollup counters kept current by every write path, so the cost is the number
+  // of nodes returned rather than the number of slugs. An empty `checklist` returns every one.
+  std::vector<StatusRollup> GetStatusRollup(RollupLevel level,
+                                            const std::string& checklist = {}) const;
+  LockProfile LockContention() const;
+  // Values read back from SQLite, which may differ from the request (e.g. mmap is capped by the
+  // build, and in-memory databases ignore it). Captured by Initialize and StartWalCheckpointer,
+  // so reading them never waits on the store lock.
+  StorageSettings EffectiveStorageSettings() const;
+  // Copies a consistent image of the database to `destination` with the online backup API.
+  // The copy reads through its own connection pinned to one WAL snapshot, so writers are never
+  // blocked; the file appears atomically (written as `<destination>.partial`, then renamed).
+  SnapshotResult Snapshot(const std::string& destination, const SnapshotOptions& options = {}) const;
+  // Preloads the database file and the pages behind the read endpoints so the first requests after
+  // a restart or restore do not pay cold-cache latency. Stops once `budget` is spent.
+  WarmUpResult WarmUp(std::chrono::milliseconds budget);
+  // Moves WAL checkpoints onto a background thread with its own connection. Commits on the store
+  // connection stop checkpointing inline (its wal_autocheckpoint reads back as 0). No-op for
+  // in-memory databases.
+  void StartWalCheckpointer(const WalCheckpointPolicy& policy);
+  std::optional<WalCheckpointStats> WalCheckpointerStats() const;
+  // The columnar slug cache (on by default) serves GetSlugOrThrow, GetSlugsForChecklist and
+  // ExportAllSlugs from memory once loaded; disabling it frees the memory.
+  void SetSlugCacheEnabled(bool enabled);
+  // Reads the (address_id, timestamp) primary key range; throws when the slug does not exist.
+  std::vector<HistoryEntry> GetHistory(const std::string& address_id,
+                                       const HistoryRange& range) const;
+  // Applies `policy` to the history of up to `max_addresses` slugs following `after_address` in
+  // Address ID order, in one short transaction, so a full pass never holds the store for long.
+  HistoryPruneBatch PruneHistory(const HistoryRetention& policy, const std::string& after_address,
+                                 std::size_t max_addresses);
+  SlugCacheStats CachedSlugStats() const;
+  // Advances each time a write method returns, so a caller can tell whether a read that started
+  // earlier may have missed a write that has since completed.
+  std::uint64_t WriteGeneration() const;
 
  private:
+  void ApplyStorageSettings();
+  StorageSettings ReadStorageSettings() const;
   void EnsureSchema();
   bool HasAnySlugs() const;
   void SeedDemoData();
   void UpsertSlug(const ChecklistSlug& slug);
   void UpsertSlugUnlocked(const ChecklistSlug& slug);
+  // Caller holds mutex_ and an open transaction. Returns the slug's new state.
+  ChecklistSlug ApplyUpdateUnlocked(const SlugUpdate& update);
+  std::vector<ChecklistSlug> ExportAllSlugsUnlocked(const Cancellation& cancel = {}) const;
   void ReplaceRelationships(const std::string& subject_id,
                             const std::vector<RelationshipEdge>& edges);
   void InsertHistorySnapshot(const ChecklistSlug& slug);
+  // Adds `delta` to the checklist, section and procedure counters for `status`.
+  void AdjustStatusRollup(const std::string& checklist, const std::string& section,
+                          const std::string& procedure, ChecklistStatus status, int delta);
   std::vector<RelationshipEdge> LoadOutgoingEdges(const std::string& address_id) const;
 
   sqlite3* db_ = nullptr;
   std::string db_path_;
+  StorageSettings storage_;
+  // Set once by Initialize, before the store is shared; only the autocheckpoint value changes
+  // afterwards (the checkpointer turns it off).
+  StorageSettings effective_storage_;
+  std::atomic<int> effective_wal_autocheckpoint_pages_{0};
   mutable std::mutex mutex_;
+  mutable LockProfiler lock_profiler_;
+  mutable std::mutex snapshot_mutex_;
+  std::unique_ptr<WalCheckpointer> wal_checkpointer_;
+  std::unique_ptr<SlugCache> slug_cache_;
+  std::atomic<std::uint64_t> write_generation_{0};
 };
 
 ChecklistStatus ParseStatus(const std::string& value);
@@ -86,5 +351,6 @@ std::string ComputeAddressId(const std::string& checklist, const std::string& se
                              const std::string& procedure, const std::string& action,
                              const std::string& spec);
 std::string CurrentTimestampIsoUtc();
+std::string FormatIsoUtc(std::chrono::system_clock::time_point when);
 
 }  // namespace core
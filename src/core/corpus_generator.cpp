@@ -0,0 +1,236 @@
+#include "core/corpus_generator.hpp"
+
+#include <array>
+#include <cmath>
+#include <ctime>
+#include <stdexcept>
+
+#include "core/checklist_markdown.hpp"
+
+namespace {
+
+using core::ChecklistSlug;
+using core::ChecklistStatus;
+using core::corpus::CorpusSpec;
+
+// SplitMix64: tiny, fast, and identical on every platform (unlike std:: distributions).
+class Rng {
+ public:
+  explicit Rng(std::uint64_t seed) : state_(seed) {}
+
+  std::uint64_t Next() {
+    std::uint64_t z = (state_ += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+  }
+
+  std::size_t Below(std::size_t bound) { return static_cast<std::size_t>(Next() % bound); }
+
+  double Unit() { return static_cast<double>(Next() >> 11) * (1.0 / 9007199254740992.0); }
+
+ private:
+  std::uint64_t state_;
+};
+
+constexpr std::array<const char*, 24> kVerbs = {
+    "Verify", "Inspect", "Measure", "Confirm", "Calibrate", "Record", "Check", "Validate",
+    "Torque", "Label", "Test", "Align", "Clean", "Secure", "Photograph", "Connect",
+    "Power", "Reset", "Configure", "Flush", "Seal", "Ground", "Tag", "Review"};
+
+constexpr std::array<const char*, 32> kNouns = {
+    "rack power", "uplink", "breaker panel", "cable tray", "fiber patch", "UPS battery",
+    "cooling loop", "fan tray", "PDU outlet", "grounding bar", "door sensor", "BMC firmware",
+    "switch stack", "DHCP scope", "NTP source", "VLAN trunk", "spare kit", "fire panel",
+    "air filter", "leak detector", "console port", "optic module", "serial label", "RAID set",
+    "boot order", "management NIC", "pressure gauge", "relief valve", "pump seal",
+    "flow meter", "camera feed", "badge reader"};
+
+constexpr std::array<const char*, 48> kWords = {
+    "the", "unit", "and", "confirm", "reading", "within", "tolerance", "before", "proceeding",
+    "use", "calibrated", "meter", "on", "each", "rail", "record", "value", "in", "result",
+    "field", "if", "out", "of", "range", "escalate", "to", "site", "lead", "with", "photo",
+    "evidence", "wait", "for", "indicator", "settle", "ensure", "lockout", "tagout", "is",
+    "applied", "verify", "label", "matches", "drawing", "torque", "fasteners", "per", "spec"};
+
+constexpr std::array<const char*, 4> kPredicates = {"depends_on", "verifies", "blocks",
+                                                    "follows"};
+
+std::uint64_t ChecklistSeed(const CorpusSpec& spec, int index) {
+  Rng mixer(spec.seed ^ (static_cast<std::uint64_t>(index) * 0xD1B54A32D192ED03ULL));
+  return mixer.Next();
+}
+
+std::string Padded(int value, int width) {
+  std::string digits = std::to_string(value);
+  if (static_cast<int>(digits.size()) < width) {
+    digits.insert(0, static_cast<std::size_t>(width) - digits.size(), '0');
+  }
+  return digits;
+}
+
+int Digits(int value) {
+  int digits = 1;
+  while (value >= 10) {
+    value /= 10;
+    ++digits;
+  }
+  return digits;
+}
+
+ChecklistStatus PickStatus(Rng& rng) {
+  const auto roll = rng.Below(100);
+  if (roll < 55) {
+    return ChecklistStatus::kPass;
+  }
+  if (roll < 70) {
+    return ChecklistStatus::kFail;
+  }
+  if (roll < 95) {
+    return ChecklistStatus::kNA;
+  }
+  return ChecklistStatus::kOther;
+}
+
+std::string Sentence(Rng& rng, int words) {
+  std::string text;
+  for (int i = 0; i < words; ++i) {
+    if (i > 0) {
+      text.push_back((i % 12 == 0) ? '\n' : ' ');
+    }
+    text += kWords[rng.Below(kWords.size())];
+  }
+  if (!text.empty()) {
+    text.push_back('.');
+  }
+  return text;
+}
+
+std::string FormatTimestamp(std::int64_t epoch_seconds) {
+  const std::time_t time = static_cast<std::time_t>(epoch_seconds);
+  std::tm tm_snapshot{};
+#if defined(_WIN32)
+  gmtime_s(&tm_snapshot, &time);
+#else
+  gmtime_r(&time, &tm_snapshot);
+#endif
+  char buffer[32];
+  std::strftime(buffer, sizeof(buffer), "%Y-%m-%dT%H:%M:%SZ", &tm_snapshot);
+  return buffer;
+}
+
+// 2025-01-01T00:00:00Z; a fixed origin keeps generated timestamps reproducible.
+constexpr std::int64_t kEpochOrigin = 1735689600;
+
+void ValidateSpec(const CorpusSpec& spec) {
+  if (spec.checklists < 1 || spec.sections < 1 || spec.procedures < 1) {
+    throw std::invalid_argument("Corpus dimensions must be positive.");
+  }
+  if (spec.relationship_density < 0.0 || spec.instruction_words < 0 || spec.history_depth < 0) {
+    throw std::invalid_argument(
+        "Corpus density, instruction length and history depth must be >= 0.");
+  }
+}
+
+}  // namespace
+
+namespace core::corpus {
+
+std::string ChecklistName(const CorpusSpec& spec, int index) {
+  return spec.checklist_prefix + "-" + Padded(index, Digits(spec.checklists));
+}
+
+std::vector<ChecklistSlug> GenerateChecklist(const CorpusSpec& spec, int index) {
+  ValidateSpec(spec);
+  Rng rng(ChecklistSeed(spec, index));
+  const std::string checklist = ChecklistName(spec, index);
+  const int section_width = Digits(spec.sections);
+  const int procedure_width = Digits(spec.procedures);
+
+  std::vector<ChecklistSlug> slugs;
+  slugs.reserve(static_cast<std::size_t>(spec.sections) *
+                static_cast<std::size_t>(spec.procedures));
+  for (int s = 0; s < spec.sections; ++s) {
+    const std::string section =
+        "Section " + Padded(s, section_width) + " " + kNouns[rng.Below(kNouns.size())];
+    for (int p = 0; p < spec.procedures; ++p) {
+      ChecklistSlug slug;
+      slug.checklist = checklist;
+      slug.section = section;
+      const std::string noun = kNouns[rng.Below(kNouns.size())];
+      slug.procedure = "Procedure " + Padded(p, procedure_width) + " " + noun;
+      slug.action = std::string{kVerbs[rng.Below(kVerbs.size())]} + " " + noun;
+      slug.spec = "Within " + std::to_string(1 + rng.Below(10)) + "% of nominal";
+      slug.status = PickStatus(rng);
+      slug.result = slug.status == ChecklistStatus::kPass ? "ok" : "";
+      slug.comment = rng.Below(4) == 0 ? Sentence(rng, 6) : "";
+      slug.timestamp = FormatTimestamp(kEpochOrigin);
+      slug.instructions = Sentence(rng, spec.instruction_words);
+      slug.address_id = ComputeAddressId(slug.checklist, slug.section, slug.procedure,
+                                         slug.action, slug.spec);
+
+      // Edges only point backwards so targets exist when ReplaceChecklist inserts them.
+      if (!slugs.empty()) {
+        const double whole = std::floor(spec.relationship_density);
+        auto edges = static_cast<std::size_t>(whole);
+        if (rng.Unit() < spec.relationship_density - whole) {
+          ++edges;
+        }
+        for (std::size_t e = 0; e < edges; ++e) {
+          const auto& target = slugs[rng.Below(slugs.size())];
+          slug.relationships.push_back(
+              {kPredicates[rng.Below(kPredicates.size())], target.address_id});
+        }
+      }
+      slugs.push_back(std::move(slug));
+    }
+  }
+  return slugs;
+}
+
+std::string GenerateChecklistMarkdown(const CorpusSpec& spec, int index) {
+  return markdown::ExportChecklistMarkdown(ChecklistName(spec, index),
+                                           GenerateChecklist(spec, index));
+}
+
+CorpusStats PopulateStore(ChecklistStore& store, const CorpusSpec& spec,
+                          const ChecklistCallback& on_checklist) {
+  ValidateSpec(spec);
+  CorpusStats stats;
+  for (int c = 0; c < spec.checklists; ++c) {
+    const std::string checklist = ChecklistName(spec, c);
+    const auto slugs = GenerateChecklist(spec, c);
+    store.ReplaceChecklist(checklist, slugs);
+
+    ++stats.checklists;
+    stats.slugs += slugs.size();
+    for (const auto& slug : slugs) {
+      stats.relationships += slug.relationships.size();
+    }
+
+    Rng rng(ChecklistSeed(spec, c) ^ 0xA5A5A5A5A5A5A5A5ULL);
+    for (int round = 0; round < spec.history_depth; ++round) {
+      std::vector<SlugUpdate> updates;
+      updates.reserve(slugs.size());
+      for (std::size_t i = 0; i < slugs.size(); ++i) {
+        SlugUpdate update;
+        update.address_id = slugs[i].address_id;
+        update.status = PickStatus(rng);
+        update.result = *update.status == ChecklistStatus::kPass ? "ok" : "retest";
+        update.comment = "round " + std::to_string(round + 1);
+        update.timestamp = FormatTimestamp(kEpochOrigin + 3600LL * (round + 1) +
+                                           static_cast<std::int64_t>(i % 3600));
+        updates.push_back(std::move(update));
+      }
+      store.ApplyBulkUpdates(updates);
+      stats.history_rows += updates.size();
+    }
+
+    if (on_checklist) {
+      on_checklist(checklist, slugs);
+    }
+  }
+  return stats;
+}
+
+}  // namespace core::corpus
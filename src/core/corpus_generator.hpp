@@ -0,0 +1,43 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "core/checklist_store.hpp"
+
+namespace core::corpus {
+
+// Shape of a synthetic corpus. Every output is a pure function of these fields, so the same
+// spec always yields byte-identical Markdown and store contents.
+struct CorpusSpec {
+  int checklists = 10;
+  int sections = 10;
+  int procedures = 20;                // per section; each procedure carries one action/spec
+  double relationship_density = 0.5;  // mean outgoing edges per slug
+  int instruction_words = 40;
+  int history_depth = 0;  // minimal updates applied per slug after import
+  std::uint64_t seed = 1;
+  std::string checklist_prefix = "synthetic";
+};
+
+struct CorpusStats {
+  std::uint64_t checklists = 0;
+  std::uint64_t slugs = 0;
+  std::uint64_t relationships = 0;
+  std::uint64_t history_rows = 0;
+};
+
+using ChecklistCallback =
+    std::function<void(const std::string& checklist, const std::vector<ChecklistSlug>& slugs)>;
+
+std::string ChecklistName(const CorpusSpec& spec, int index);
+std::vector<ChecklistSlug> GenerateChecklist(const CorpusSpec& spec, int index);
+std::string GenerateChecklistMarkdown(const CorpusSpec& spec, int index);
+
+// Imports every checklist through ReplaceChecklist, then replays `history_depth` updates per slug.
+CorpusStats PopulateStore(ChecklistStore& store, const CorpusSpec& spec,
+                          const ChecklistCallback& on_checklist = {});
+
+}  // namespace core::corpus
@@ -0,0 +1,88 @@
+#include "core/history_retention.hpp"
+
+#include <string>
+#include <utility>
+
+#include "core/logging.hpp"
+
+namespace core {
+namespace {
+
+using core::logging::LogInfo;
+using core::logging::LogWarn;
+
+}  // namespace
+
+HistoryRetentionJob::HistoryRetentionJob(ChecklistStore& store, HistoryRetentionSchedule schedule)
+    : store_(store), schedule_(std::move(schedule)) {}
+
+HistoryRetentionJob::~HistoryRetentionJob() { Stop(); }
+
+void HistoryRetentionJob::Start() {
+  if (!schedule_.policy.Enabled() || worker_.joinable()) {
+    return;
+  }
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stopping_ = false;
+  }
+  LogInfo("History retention every " + std::to_string(schedule_.interval.count()) + "s (max age " +
+          std::to_string(schedule_.policy.max_age.count()) + "s, max per slug " +
+          std::to_string(schedule_.policy.max_per_address) + ", downsample after " +
+          std::to_string(schedule_.policy.downsample_after.count()) + "s)");
+  worker_ = std::thread([this] { Run(); });
+}
+
+void HistoryRetentionJob::Stop() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stopping_ = true;
+  }
+  wake_.notify_all();
+  if (worker_.joinable()) {
+    worker_.join();
+  }
+}
+
+bool HistoryRetentionJob::Stopping() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return stopping_;
+}
+
+std::int64_t HistoryRetentionJob::RunPass() {
+  const auto started = std::chrono::steady_clock::now();
+  std::int64_t deleted = 0;
+  std::size_t addresses = 0;
+  std::string cursor;
+  do {
+    const auto batch = store_.PruneHistory(schedule_.policy, cursor, schedule_.batch_addresses);
+    deleted += batch.rows_deleted;
+    addresses += batch.addresses;
+    cursor = batch.next_address;
+    if (!cursor.empty() && schedule_.batch_pause.count() > 0) {
+      std::unique_lock<std::mutex> lock(mutex_);
+      wake_.wait_for(lock, schedule_.batch_pause, [this] { return stopping_; });
+    }
+  } while (!cursor.empty() && !Stopping());
+
+  const auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+      std::chrono::steady_clock::now() - started);
+  LogInfo("History retention removed " + std::to_string(deleted) + " rows across " +
+          std::to_string(addresses) + " slugs in " + std::to_string(elapsed.count()) + " ms");
+  return deleted;
+}
+
+void HistoryRetentionJob::Run() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  do {
+    lock.unlock();
+    try {
+      RunPass();
+    } catch (const std::exception& ex) {
+      LogWarn(std::string{"History retention pass failed: "} + ex.what());
+    }
+    lock.lock();
+  } while (!wake_.wait_for(lock, schedule_.interval, [this] { return stopping_; }));
+}
+
+}  // namespace core
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+
+#include "core/checklist_store.hpp"
+
+namespace core {
+
+struct HistoryRetentionSchedule {
+  HistoryRetention policy;
+  std::chrono::seconds interval{3600};  // pause between full passes
+  std::size_t batch_addresses = 200;    // slugs handled per transaction
+  std::chrono::milliseconds batch_pause{10};
+};
+
+// Enforces a HistoryRetention policy in the background: each pass walks every slug in Address ID
+// order, `batch_addresses` at a time, releasing the store between batches so request latency
+// is unaffected.
+class HistoryRetentionJob {
+ public:
+  HistoryRetentionJob(ChecklistStore& store, HistoryRetentionSchedule schedule);
+  ~HistoryRetentionJob();
+
+  HistoryRetentionJob(const HistoryRetentionJob&) = delete;
+  HistoryRetentionJob& operator=(const HistoryRetentionJob&) = delete;
+
+  void Start();
+  void Stop();
+  // Runs one full pass on the calling thread and returns the number of rows removed.
+  std::int64_t RunPass();
+
+ private:
+  void Run();
+  bool Stopping();
+
+  ChecklistStore& store_;
+  HistoryRetentionSchedule schedule_;
+  std::thread worker_;
+  std::mutex mutex_;
+  std::condition_variable wake_;
+  bool stopping_ = false;
+};
+
+}  // namespace core
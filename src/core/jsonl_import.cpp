@@ -0,0 +1,129 @@
+#include "core/jsonl_import.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+#include <utility>
+
+#include "core/api_json.hpp"
+#include "nlohmann/json.hpp"
+
+namespace core {
+
+JsonlImporter::JsonlImporter(ChecklistStore& store, std::size_t batch_size, Cancellation cancel)
+    : store_(store),
+      batch_size_(std::clamp<std::size_t>(batch_size, 1, kMaxBatchSize)),
+      cancel_(std::move(cancel)) {
+  batch_.reserve(batch_size_);
+  batch_lines_.reserve(batch_size_);
+}
+
+void JsonlImporter::Feed(std::string_view chunk) {
+  while (!chunk.empty()) {
+    const auto newline = chunk.find('\n');
+    const auto piece = chunk.substr(0, newline);
+    if (!skipping_oversized_) {
+      if (partial_.size() + piece.size() > kMaxLineBytes) {
+        ++line_number_;
+        ++report_.lines;
+        ++report_.failed;
+        RecordError(line_number_, "Line exceeds " + std::to_string(kMaxLineBytes) + " bytes.");
+        partial_.clear();
+        skipping_oversized_ = true;
+      } else {
+        partial_.append(piece);
+      }
+    }
+    if (newline == std::string_view::npos) {
+      return;
+    }
+    if (skipping_oversized_) {
+      skipping_oversized_ = false;
+    } else {
+      ++line_number_;
+      ProcessLine(partial_);
+      partial_.clear();
+    }
+    chunk.remove_prefix(newline + 1);
+  }
+}
+
+JsonlImportReport JsonlImporter::Finish() {
+  if (!partial_.empty() && !skipping_oversized_) {
+    ++line_number_;
+    ProcessLine(partial_);
+  }
+  partial_.clear();
+  FlushBatch();
+
+  if (!deferred_.empty()) {
+    const auto unresolved = store_.AddRelationships(deferred_);
+    report_.relationships_unresolved = unresolved.size();
+    for (const auto& pending : unresolved) {
+      RecordError(pending.index, "Relationship target not found: " + pending.edge.predicate +
+                                     " -> " + pending.edge.target);
+    }
+    deferred_.clear();
+  }
+
+  std::sort(report_.errors.begin(), report_.errors.end(),
+            [](const auto& a, const auto& b) { return a.line < b.line; });
+  return std::move(report_);
+}
+
+void JsonlImporter::ProcessLine(std::string_view line) {
+  if (!line.empty() && line.back() == '\r') {
+    line.remove_suffix(1);
+  }
+  if (line.find_first_not_of(" \t") == std::string_view::npos) {
+    return;
+  }
+  ++report_.lines;
+
+  const auto record = nlohmann::json::parse(line.begin(), line.end(), nullptr, false);
+  if (record.is_discarded()) {
+    RecordError(line_number_, "Invalid JSON.");
+    ++report_.failed;
+    return;
+  }
+  try {
+    batch_.push_back(ParseSlugRecord(record));
+    batch_lines_.push_back(line_number_);
+  } catch (const std::exception& ex) {
+    RecordError(line_number_, ex.what());
+    ++report_.failed;
+    return;
+  }
+  if (batch_.size() >= batch_size_) {
+    FlushBatch();
+  }
+}
+
+void JsonlImporter::FlushBatch() {
+  if (batch_.empty()) {
+    return;
+  }
+  auto result = store_.ImportSlugs(batch_, cancel_);
+  ++report_.batches;
+  report_.imported += result.upserted;
+  report_.failed += result.failures.size();
+  for (auto& failure : result.failures) {
+    RecordError(batch_lines_[failure.index], std::move(failure.error));
+  }
+  report_.relationships_deferred += result.deferred.size();
+  for (auto& pending : result.deferred) {
+    pending.index = batch_lines_[pending.index];
+    deferred_.push_back(std::move(pending));
+  }
+  batch_.clear();
+  batch_lines_.clear();
+}
+
+void JsonlImporter::RecordError(std::size_t line, std::string error) {
+  if (report_.errors.size() >= kMaxReportedErrors) {
+    ++report_.errors_truncated;
+    return;
+  }
+  report_.errors.push_back({line, std::move(error)});
+}
+
+}  // namespace core
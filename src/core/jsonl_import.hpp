@@ -0,0 +1,64 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "core/checklist_store.hpp"
+
+namespace core {
+
+struct JsonlImportError {
+  std::size_t line = 0;
+  std::string error;
+};
+
+struct JsonlImportReport {
+  std::size_t lines = 0;  // non-blank lines seen
+  std::size_t imported = 0;
+  std::size_t failed = 0;
+  std::size_t batches = 0;
+  std::size_t relationships_deferred = 0;    // edges that arrived before their target
+  std::size_t relationships_unresolved = 0;  // deferred edges whose target never arrived
+  std::vector<JsonlImportError> errors;      // first kMaxReportedErrors only
+  std::size_t errors_truncated = 0;
+};
+
+// Incremental importer for `/api/export/jsonl` records. Feed it body chunks in any split; complete
+// lines are parsed immediately and upserted `batch_size` records per transaction, so memory stays
+// bounded by one batch plus the edges waiting on targets from later batches. Each committed batch
+// is durable on its own, and re-running an import is idempotent because records are upserts.
+class JsonlImporter {
+ public:
+  static constexpr std::size_t kDefaultBatchSize = 500;
+  static constexpr std::size_t kMaxBatchSize = 10000;
+  static constexpr std::size_t kMaxLineBytes = 1 << 20;
+  static constexpr std::size_t kMaxReportedErrors = 100;
+
+  // A fired `cancel` rolls back the batch in progress and stops the import; earlier batches stay.
+  JsonlImporter(ChecklistStore& store, std::size_t batch_size = kDefaultBatchSize,
+                Cancellation cancel = {});
+
+  void Feed(std::string_view chunk);
+  // Flushes the trailing line and final batch, then retries deferred relationships.
+  JsonlImportReport Finish();
+
+ private:
+  void ProcessLine(std::string_view line);
+  void FlushBatch();
+  void RecordError(std::size_t line, std::string error);
+
+  ChecklistStore& store_;
+  std::size_t batch_size_;
+  Cancellation cancel_;
+  std::string partial_;
+  bool skipping_oversized_ = false;
+  std::size_t line_number_ = 0;
+  std::vector<ChecklistSlug> batch_;
+  std::vector<std::size_t> batch_lines_;
+  std::vector<PendingRelationship> deferred_;  // index holds the source line number
+  JsonlImportReport report_;
+};
+
+}  // namespace core
@@ -0,0 +1,74 @@
+#include "core/lock_profiler.hpp"
+
+#include <algorithm>
+
+namespace core {
+
+LockProfiler::LockProfiler(std::size_t max_holders) : max_holders_(max_holders) {}
+
+void LockProfiler::Record(std::string_view site, std::chrono::nanoseconds wait,
+                          std::chrono::nanoseconds hold) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto it = sites_.find(site);
+  if (it == sites_.end()) {
+    it = sites_.emplace(std::string{site}, LockSiteStats{}).first;
+    it->second.site = it->first;
+  }
+
+  auto& stats = it->second;
+  ++stats.acquisitions;
+  stats.total_wait += wait;
+  stats.total_hold += hold;
+  stats.max_wait = std::max(stats.max_wait, wait);
+  stats.max_hold = std::max(stats.max_hold, hold);
+
+  if (max_holders_ == 0) {
+    return;
+  }
+  // Keep the N longest holds sorted descending so the snapshot is a plain copy.
+  if (longest_holders_.size() >= max_holders_ && longest_holders_.back().hold >= hold) {
+    return;
+  }
+  LockHoldSample sample{std::string{site}, wait, hold, std::chrono::system_clock::now()};
+  const auto pos = std::upper_bound(
+      longest_holders_.begin(), longest_holders_.end(), hold,
+      [](std::chrono::nanoseconds value, const LockHoldSample& s) { return value > s.hold; });
+  longest_holders_.insert(pos, std::move(sample));
+  if (longest_holders_.size() > max_holders_) {
+    longest_holders_.pop_back();
+  }
+}
+
+LockProfile LockProfiler::Snapshot() const {
+  LockProfile profile;
+  std::lock_guard<std::mutex> lock(mutex_);
+  profile.sites.reserve(sites_.size());
+  for (const auto& entry : sites_) {
+    profile.sites.push_back(entry.second);
+  }
+  profile.longest_holders = longest_holders_;
+  return profile;
+}
+
+void LockProfiler::Reset() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  sites_.clear();
+  longest_holders_.clear();
+}
+
+ProfiledLock::ProfiledLock(std::mutex& mutex, LockProfiler& profiler, std::string_view site)
+    : mutex_(mutex),
+      profiler_(profiler),
+      site_(site),
+      requested_(std::chrono::steady_clock::now()) {
+  mutex_.lock();
+  acquired_ = std::chrono::steady_clock::now();
+}
+
+ProfiledLock::~ProfiledLock() {
+  const auto released = std::chrono::steady_clock::now();
+  mutex_.unlock();
+  profiler_.Record(site_, acquired_ - requested_, released - acquired_);
+}
+
+}  // namespace core
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace core {
+
+struct LockSiteStats {
+  std::string site;
+  std::uint64_t acquisitions = 0;
+  std::chrono::nanoseconds total_wait{0};
+  std::chrono::nanoseconds max_wait{0};
+  std::chrono::nanoseconds total_hold{0};
+  std::chrono::nanoseconds max_hold{0};
+};
+
+struct LockHoldSample {
+  std::string site;
+  std::chrono::nanoseconds wait{0};
+  std::chrono::nanoseconds hold{0};
+  std::chrono::system_clock::time_point released_at;
+};
+
+struct LockProfile {
+  std::vector<LockSiteStats> sites;
+  std::vector<LockHoldSample> longest_holders;
+};
+
+// Aggregates wait/hold durations per call site for a single mutex.
+class LockProfiler {
+ public:
+  explicit LockProfiler(std::size_t max_holders = 10);
+
+  void Record(std::string_view site, std::chrono::nanoseconds wait,
+              std::chrono::nanoseconds hold);
+  LockProfile Snapshot() const;
+  void Reset();
+
+ private:
+  std::size_t max_holders_;
+  mutable std::mutex mutex_;
+  std::map<std::string, LockSiteStats, std::less<>> sites_;
+  std::vector<LockHoldSample> longest_holders_;
+};
+
+// RAII guard that locks `mutex` and reports wait/hold time to `profiler` on release.
+class ProfiledLock {
+ public:
+  ProfiledLock(std::mutex& mutex, LockProfiler& profiler, std::string_view site);
+  ~ProfiledLock();
+
+  ProfiledLock(const ProfiledLock&) = delete;
+  ProfiledLock& operator=(const ProfiledLock&) = delete;
+
+ private:
+  std::mutex& mutex_;
+  LockProfiler& profiler_;
+  std::string_view site_;
+  std::chrono::steady_clock::time_point requested_;
+  std::chrono::steady_clock::time_point acquired_;
+};
+
+}  // namespace core
@@ -1,27 +1,102 @@
+#include <chrono>
+#include <cstdint>
 #include <exception>
 #include <string>
 
 #include "core/app.hpp"
 #include "core/checklist_store.hpp"
+#include "core/history_retention.hpp"
 #include "core/logging.hpp"
+#include "core/snapshot.hpp"
 #include "platform/http_server.hpp"
 
+namespace {
+
+std::int64_t MillisSince(std::chrono::steady_clock::time_point start) {
+  return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() -
+                                                               start)
+      .count();
+}
+
+}  // namespace
+
 int main() {
+  const auto process_start = std::chrono::steady_clock::now();
   core::logging::InitializeFromEnvironment();
   const auto config = core::LoadServerConfig();
+  core::StartupReport startup;
+
+  if (!config.restore_from.empty()) {
+    try {
+      if (const auto restored =
+              core::RestoreSnapshotOnce(config.restore_from, config.database_path)) {
+        startup.restored_from = config.restore_from;
+        startup.restore_ms = restored->duration.count();
+      }
+    } catch (const std::exception& ex) {
+      core::logging::LogError(std::string{"Restore failed: "} + ex.what());
+      return 1;
+    }
+  }
 
   core::logging::LogInfo("Opening runtime store at " + config.database_path +
-                         (config.seed_demo_data ? " (seed enabled)" : " (seed disabled)"));
-  core::ChecklistStore store(config.database_path);
+                         (config.seed_demo_data ? " (seed enabled)" : " (seed disabled)") +
+                         ", storage profile " + config.storage.profile);
+  const auto open_start = std::chrono::steady_clock::now();
+  core::ChecklistStore store(config.database_path, config.storage);
+  store.SetSlugCacheEnabled(config.slug_cache);
   store.Initialize(config.seed_demo_data);
+  if (config.wal_checkpoint_interval_ms > 0) {
+    core::WalCheckpointPolicy policy;
+    policy.interval = std::chrono::milliseconds(config.wal_checkpoint_interval_ms);
+    policy.wal_pages_threshold = config.wal_checkpoint_pages;
+    policy.truncate_after_idle = std::chrono::milliseconds(config.wal_truncate_idle_ms);
+    store.StartWalCheckpointer(policy);
+  }
+  startup.open_ms = MillisSince(open_start);
+
+  if (config.warmup_budget_ms > 0) {
+    const auto warm = store.WarmUp(std::chrono::milliseconds(config.warmup_budget_ms));
+    startup.warmup_ms = warm.duration.count();
+    startup.warmup_bytes = warm.bytes_read;
+    startup.warmup_rows = warm.rows_visited;
+    startup.warmup_complete = warm.complete;
+  }
 
   platform::HttpServer server;
-  core::ConfigureServer(server, store);
+  core::ConfigureServer(server, store, config);
+
+  core::SnapshotSchedule schedule;
+  schedule.directory = config.snapshot_directory;
+  schedule.interval = std::chrono::seconds(config.snapshot_interval_seconds);
+  schedule.keep = config.snapshot_keep;
+  schedule.options.pages_per_step = config.snapshot_pages_per_step;
+  schedule.options.step_pause = std::chrono::milliseconds(config.snapshot_step_pause_ms);
+  core::SnapshotScheduler snapshots(store, schedule);
+  snapshots.Start();
+
+  core::HistoryRetentionSchedule retention;
+  retention.policy.max_age = std::chrono::hours(24) * config.history_max_age_days;
+  retention.policy.max_per_address = config.history_max_per_slug;
+  retention.policy.downsample_after = std::chrono::hours(config.history_downsample_after_hours);
+  retention.policy.downsample_bucket =
+      std::chrono::minutes(config.history_downsample_bucket_minutes);
+  retention.interval = std::chrono::seconds(config.history_retention_interval_seconds);
+  retention.batch_addresses = static_cast<std::size_t>(config.history_retention_batch);
+  core::HistoryRetentionJob history_retention(store, retention);
+  history_retention.Start();
 
+  startup.ready_ms = MillisSince(process_start);
+  core::SetStartupReport(startup);
   core::logging::LogInfo("Starting APIM demo server on " + config.host + ":" +
-                         std::to_string(config.port));
+                         std::to_string(config.port) + " (ready in " +
+                         std::to_string(startup.ready_ms) + " ms)");
 
   try {
+    if (!config.unix_socket_path.empty()) {
+      server.ListenOnUnixSocket(config.unix_socket_path);
+      core::logging::LogInfo("Also listening on Unix socket " + config.unix_socket_path);
+    }
     server.Start(config.host, config.port);
   } catch (const std::exception& ex) {
     core::logging::LogError(std::string{"Server terminated with error: "} + ex.what());
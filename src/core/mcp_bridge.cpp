@@ -1,9 +1,14 @@
 #include "core/mcp_bridge.hpp"
 
+#include <algorithm>
 #include <map>
+#include <memory>
+#include <optional>
 #include <sstream>
 #include <stdexcept>
 
+#include "core/slug_cursor.hpp"
+
 namespace core::mcp {
 namespace {
 
@@ -76,6 +81,21 @@ const std::vector<ToolDefinition>& ToolCatalog() {
            {{"type", "string"}, {"description", "Address ID to retrieve."}}}}},
         {"required", {"address_id"}},
         {"additionalProperties", false}}},
+      {"apim.get_slugs",
+       "POST",
+       "/api/slugs",
+       "Fetch many slugs by Address ID in one call; unknown IDs are returned under 'missing'.",
+       {{"type", "object"},
+        {"properties",
+         {{"address_ids",
+           {{"type", "array"},
+            {"items", {{"type", "string"}}},
+            {"description", "Address IDs to retrieve (at most 1000)."}}},
+          {"fields",
+           {{"type", "string"},
+            {"description", "Comma-separated slug fields to return (default: all)."}}}}},
+        {"required", {"address_ids"}},
+        {"additionalProperties", false}}},
       {"apim.get_checklist",
        "GET",
        "/api/checklist/{checklist}",
@@ -83,9 +103,32 @@ const std::vector<ToolDefinition>& ToolCatalog() {
        {{"type", "object"},
         {"properties",
          {{"checklist",
-           {{"type", "string"}, {"description", "Checklist name to retrieve."}}}}},
+           {{"type", "string"}, {"description", "Checklist name to retrieve."}}},
+          {"cursor",
+           {{"type", "string"},
+            {"description", "Continue from this cursor (from a truncated result)."}}},
+          {"limit", {{"type", "integer"}, {"description", "Maximum slugs to return."}}},
+          {"fields",
+           {{"type", "string"}, {"description", "Comma-separated slug fields to return."}}},
+          {"status",
+           {{"type", "string"}, {"description", "Comma-separated statuses to keep."}}}}},
         {"required", {"checklist"}},
         {"additionalProperties", false}}},
+      {"apim.search",
+       "GET",
+       "/api/search",
+       "Find slugs by words in their action, spec, or instructions, best matches first.",
+       {{"type", "object"},
+        {"properties",
+         {{"query",
+           {{"type", "string"},
+            {"description", "Words to search for; the last word also matches as a prefix."}}},
+          {"checklist",
+           {{"type", "string"},
+            {"description", "Comma-separated checklist names to restrict the search to."}}},
+          {"limit", {{"type", "integer"}, {"description", "Maximum results (1-100, default 20)."}}}}},
+        {"required", {"query"}},
+        {"additionalProperties", false}}},
       {"apim.relationships",
        "GET",
        "/api/relationships/{address_id}",
@@ -112,11 +155,42 @@ const std::vector<ToolDefinition>& ToolCatalog() {
            {{"type", "string"}, {"description", "ISO8601 timestamp override (optional)."}}}}},
         {"required", {"address_id"}},
         {"additionalProperties", false}}},
+      {"apim.update_slugs",
+       "PATCH",
+       "/api/update_bulk",
+       "Apply update_slug changes to many slugs in one all-or-nothing transaction.",
+       {{"type", "object"},
+        {"properties",
+         {{"updates",
+           {{"type", "array"},
+            {"items",
+             {{"type", "object"},
+              {"properties",
+               {{"address_id", {{"type", "string"}}},
+                {"status", {{"type", "string"}}},
+                {"result", {{"type", "string"}}},
+                {"comment", {{"type", "string"}}},
+                {"timestamp", {{"type", "string"}}}}},
+              {"required", {"address_id"}},
+              {"additionalProperties", false}}},
+            {"description", "One entry per slug, each shaped like apim.update_slug arguments."}}}}},
+        {"required", {"updates"}},
+        {"additionalProperties", false}}},
       {"apim.export_json",
        "GET",
        "/api/export/json",
        "Export every slug as a JSON array for downstream processing.",
-       nlohmann::json::object()},
+       {{"type", "object"},
+        {"properties",
+         {{"cursor",
+           {{"type", "string"},
+            {"description", "Continue from this cursor (from a truncated result)."}}},
+          {"limit", {{"type", "integer"}, {"description", "Maximum slugs to return."}}},
+          {"fields",
+           {{"type", "string"}, {"description", "Comma-separated slug fields to return."}}},
+          {"status",
+           {{"type", "string"}, {"description", "Comma-separated statuses to keep."}}}}},
+        {"additionalProperties", false}}},
       {"apim.export_markdown",
        "GET",
        "/api/export/markdown/{checklist}",
@@ -173,9 +247,168 @@ std::string RequireStringArg(const nlohmann::json& arguments, const std::string&
   return it->get<std::string>();
 }
 
+const nlohmann::json& RequireArrayArg(const nlohmann::json& arguments, const std::string& key) {
+  const auto it = arguments.find(key);
+  if (it == arguments.end() || !it->is_array()) {
+    throw std::invalid_argument("Missing or invalid argument: " + key);
+  }
+  return *it;
+}
+
+nlohmann::json MakeUpdatePayload(const nlohmann::json& arguments) {
+  nlohmann::json payload = nlohmann::json::object();
+  payload["address_id"] = RequireStringArg(arguments, "address_id");
+  for (const char* key : {"status", "result", "comment", "timestamp"}) {
+    if (const auto it = arguments.find(key); it != arguments.end()) {
+      payload[key] = ToString(*it);
+    }
+  }
+  return payload;
+}
+
+// Maps listing tool arguments onto the server's keyset pagination parameters.
+std::map<std::string, std::string> SlugListingQuery(const nlohmann::json& arguments) {
+  std::map<std::string, std::string> query;
+  for (const char* key : {"fields", "status", "limit", "cursor"}) {
+    if (const auto it = arguments.find(key); it != arguments.end()) {
+      query[key] = ToString(*it);
+    }
+  }
+  return query;
+}
+
+std::string ContinuationNote(const std::string& cursor) {
+  if (cursor.empty()) {
+    return {};
+  }
+  return "\n[more results: call again with \"cursor\": \"" + cursor + "\"]";
+}
+
+// Cuts at or below `max_bytes` without splitting a UTF-8 sequence.
+std::string TruncateUtf8(const std::string& text, std::size_t max_bytes) {
+  std::size_t end = std::min(max_bytes, text.size());
+  while (end > 0 && end < text.size() &&
+         (static_cast<unsigned char>(text[end]) & 0xC0) == 0x80) {
+    --end;
+  }
+  return text.substr(0, end);
+}
+
+struct TrimResult {
+  std::size_t kept = 0;
+  std::size_t total = 0;
+  std::string cursor;
+};
+
+// Drops trailing items from the payload's listing (the top-level array, or the largest array
+// member of a top-level object) until it dumps within `max_bytes`. Returns nullopt when there is
+// no such array or not even one item fits. Only a `pageable` payload gets a cursor.
+std::optional<TrimResult> TrimToBudget(nlohmann::json& payload, int indent, std::size_t max_bytes,
+                                       bool pageable) {
+  nlohmann::json* items = nullptr;
+  if (payload.is_array()) {
+    items = &payload;
+  } else if (payload.is_object()) {
+    for (auto& [key, value] : payload.items()) {
+      if (value.is_array() && (!items || value.size() > items->size())) {
+        items = &value;
+      }
+    }
+  }
+  if (!items || items->empty()) {
+    return std::nullopt;
+  }
+
+  TrimResult result;
+  result.total = items->size();
+  nlohmann::json all = std::move(*items);
+  *items = nlohmann::json::array();
+  const std::size_t skeleton = payload.dump(indent).size();
+  // Per-item cost is estimated from a standalone dump plus the separator and, when indenting,
+  // the deeper nesting of every line; the final dump below corrects any estimate error.
+  const std::size_t depth = items == &payload ? 1 : 2;
+  std::size_t used = skeleton;
+  for (const auto& item : all) {
+    const auto dumped = item.dump(indent);
+    std::size_t cost = dumped.size() + 1;
+    if (indent > 0) {
+      cost += (std::count(dumped.begin(), dumped.end(), '\n') + 1) * indent * depth + 1;
+    }
+    if (used + cost > max_bytes) {
+      break;
+    }
+    used += cost;
+    items->push_back(item);
+  }
+  while (!items->empty() && payload.dump(indent).size() > max_bytes) {
+    items->erase(items->end() - 1);
+  }
+  if (items->empty()) {
+    *items = std::move(all);
+    return std::nullopt;
+  }
+
+  result.kept = items->size();
+  if (!pageable) {
+    return result;
+  }
+  // The cursor carries the last kept slug's sort key, so it stays valid if that slug is deleted.
+  // When `fields` projected the key away, only the bare address_id is left to resume from.
+  const auto& last = items->back();
+  if (last.is_object() && last.contains("address_id") && last["address_id"].is_string()) {
+    const auto text = [&last](const char* key) -> const std::string* {
+      const auto it = last.find(key);
+      return it != last.end() && it->is_string() ? it->get_ptr<const std::string*>() : nullptr;
+    };
+    const auto* checklist = text("checklist");
+    const auto* section = text("section");
+    const auto* procedure = text("procedure");
+    const auto* action = text("action");
+    result.cursor = last["address_id"].get<std::string>();
+    if (checklist && section && procedure && action) {
+      result.cursor =
+          EncodeSlugCursor({*checklist, *section, *procedure, *action, result.cursor});
+    }
+  }
+  if (payload.is_object() && payload.contains("next_cursor")) {
+    payload["next_cursor"] =
+        result.cursor.empty() ? nlohmann::json(nullptr) : nlohmann::json(result.cursor);
+  }
+  return result;
+}
+
 }  // namespace
 
-Bridge::Bridge(std::string base_url) : client_(std::move(base_url)) {}
+Bridge::Bridge(std::string base_url, std::size_t max_connections) {
+  auto client = std::make_shared<platform::HttpClient>(std::move(base_url), max_connections);
+  transport_ = [client](const ToolRequest& request) {
+    if (request.method == "GET") {
+      return client->Get(request.path, request.query);
+    }
+    if (request.method == "POST") {
+      return client->Post(request.path, request.body, request.query, request.content_type);
+    }
+    return client->Patch(request.path, request.body, request.query, request.content_type);
+  };
+}
+
+Bridge::Bridge(ToolTransport transport) : transport_(std::move(transport)) {}
+
+platform::HttpClientResponse Bridge::Get(const std::string& path,
+                                         const std::map<std::string, std::string>& query) const {
+  return transport_({"GET", path, query, {}, {}});
+}
+
+platform::HttpClientResponse Bridge::Post(const std::string& path, const std::string& body,
+                                          const std::map<std::string, std::string>& query,
+                                          const std::string& content_type) const {
+  return transport_({"POST", path, query, body, content_type});
+}
+
+platform::HttpClientResponse Bridge::Patch(const std::string& path,
+                                           const std::string& body) const {
+  return transport_({"PATCH", path, {}, body, "application/json"});
+}
 
 nlohmann::json Bridge::ToolSchemasJson() const {
   nlohmann::json tools = nlohmann::json::array();
@@ -190,20 +423,20 @@ const std::vector<ToolDefinition>& Bridge::Definitions() const { return ToolCata
 platform::HttpClientResponse Bridge::CallTool(const std::string& name,
                                               const nlohmann::json& arguments) const {
   if (name == "apim.list_commands") {
-    return client_.Get("/api/commands");
+    return Get("/api/commands");
   }
   if (name == "apim.list_checklists") {
-    return client_.Get("/api/checklists");
+    return Get("/api/checklists");
   }
   if (name == "apim.health") {
-    return client_.Get("/api/health");
+    return Get("/api/health");
   }
   if (name == "apim.hello") {
     std::map<std::string, std::string> query;
     if (const auto it = arguments.find("name"); it != arguments.end()) {
       query["name"] = ToString(*it);
     }
-    return client_.Get("/api/hello", query);
+    return Get("/api/hello", query);
   }
   if (name == "apim.echo") {
     const auto it = arguments.find("payload");
@@ -211,54 +444,92 @@ platform::HttpClientResponse Bridge::CallTool(const std::string& name,
       throw std::invalid_argument("apim.echo requires a 'payload' argument");
     }
     const std::string payload = ToString(*it);
-    return client_.Post("/api/echo", payload);
+    return Post("/api/echo", payload);
   }
   if (name == "apim.get_slug") {
     const auto id = EncodePathSegment(RequireStringArg(arguments, "address_id"));
-    return client_.Get("/api/slug/" + id);
+    return Get("/api/slug/" + id);
+  }
+  if (name == "apim.get_slugs") {
+    nlohmann::json payload = {{"address_ids", RequireArrayArg(arguments, "address_ids")}};
+    if (const auto it = arguments.find("fields"); it != arguments.end()) {
+      payload["fields"] = ToString(*it);
+    }
+    return Post("/api/slugs", payload.dump());
   }
   if (name == "apim.get_checklist") {
     const auto checklist = EncodePathSegment(RequireStringArg(arguments, "checklist"));
-    return client_.Get("/api/checklist/" + checklist);
+    return Get("/api/checklist/" + checklist, SlugListingQuery(arguments));
+  }
+  if (name == "apim.search") {
+    std::map<std::string, std::string> query{{"q", RequireStringArg(arguments, "query")}};
+    if (const auto it = arguments.find("checklist"); it != arguments.end()) {
+      query["checklist"] = ToString(*it);
+    }
+    if (const auto it = arguments.find("limit"); it != arguments.end()) {
+      query["limit"] = ToString(*it);
+    }
+    return Get("/api/search", query);
   }
   if (name == "apim.relationships") {
     const auto id = EncodePathSegment(RequireStringArg(arguments, "address_id"));
-    return client_.Get("/api/relationships/" + id);
+    return Get("/api/relationships/" + id);
   }
   if (name == "apim.update_slug") {
-    nlohmann::json payload = nlohmann::json::object();
-    payload["address_id"] = RequireStringArg(arguments, "address_id");
-    if (const auto it = arguments.find("status"); it != arguments.end()) {
-      payload["status"] = ToString(*it);
-    }
-    if (const auto it = arguments.find("result"); it != arguments.end()) {
-      payload["result"] = ToString(*it);
-    }
-    if (const auto it = arguments.find("comment"); it != arguments.end()) {
-      payload["comment"] = ToString(*it);
-    }
-    if (const auto it = arguments.find("timestamp"); it != arguments.end()) {
-      payload["timestamp"] = ToString(*it);
+    return Patch("/api/update", MakeUpdatePayload(arguments).dump());
+  }
+  if (name == "apim.update_slugs") {
+    nlohmann::json payload = nlohmann::json::array();
+    for (const auto& update : RequireArrayArg(arguments, "updates")) {
+      if (!update.is_object()) {
+        throw std::invalid_argument("Each entry in 'updates' must be an object");
+      }
+      payload.push_back(MakeUpdatePayload(update));
     }
-    return client_.Patch("/api/update", payload.dump());
+    return Patch("/api/update_bulk", payload.dump());
   }
   if (name == "apim.export_json") {
-    return client_.Get("/api/export/json");
+    return Get("/api/export/json", SlugListingQuery(arguments));
   }
   if (name == "apim.export_markdown") {
     const auto checklist = EncodePathSegment(RequireStringArg(arguments, "checklist"));
-    return client_.Get("/api/export/markdown/" + checklist);
+    return Get("/api/export/markdown/" + checklist);
   }
   if (name == "apim.import_markdown") {
     const auto checklist = RequireStringArg(arguments, "checklist");
     const auto markdown = RequireStringArg(arguments, "markdown");
-    return client_.Post("/api/import/markdown", markdown, {{"checklist", checklist}},
-                        "text/markdown");
+    return Post("/api/import/markdown", markdown, {{"checklist", checklist}}, "text/markdown");
   }
   throw std::invalid_argument("Unknown tool: " + name);
 }
 
-std::string FormatResponseForDisplay(const platform::HttpClientResponse& response) {
+nlohmann::json Bridge::CallToolContent(const nlohmann::json& params,
+                                       const DisplayOptions& display) const {
+  const std::string tool_name = params.at("name").get<std::string>();
+  const auto arguments =
+      params.contains("arguments") ? params.at("arguments") : nlohmann::json::object();
+  const auto response = CallTool(tool_name, arguments);
+  // A continuation cursor is only worth offering to a tool that can be called with one.
+  DisplayOptions options = display;
+  const auto& definitions = Definitions();
+  const auto tool = std::find_if(definitions.begin(), definitions.end(),
+                                 [&](const ToolDefinition& def) { return def.name == tool_name; });
+  options.pageable = tool != definitions.end() && tool->input_schema.contains("properties") &&
+                     tool->input_schema["properties"].contains("cursor");
+  const std::string text = FormatResponseForDisplay(response, options);
+  return {{"content", nlohmann::json::array({{{"type", "text"}, {"text", text}}})}};
+}
+
+nlohmann::json MakeResultPayload(const nlohmann::json& id, const nlohmann::json& result) {
+  return {{"jsonrpc", "2.0"}, {"id", id}, {"result", result}};
+}
+
+nlohmann::json MakeErrorPayload(const nlohmann::json& id, int code, const std::string& message) {
+  return {{"jsonrpc", "2.0"}, {"id", id}, {"error", {{"code", code}, {"message", message}}}};
+}
+
+std::string FormatResponseForDisplay(const platform::HttpClientResponse& response,
+                                     const DisplayOptions& options) {
   std::ostringstream stream;
   stream << "HTTP " << response.status;
   if (!response.content_type.empty()) {
@@ -266,12 +537,44 @@ std::string FormatResponseForDisplay(const platform::HttpClientResponse& respons
   }
   stream << '\n';
 
-  const auto parsed = TryParseJson(response.body);
-  if (!parsed.empty()) {
-    stream << parsed.dump(2);
-  } else {
-    stream << response.body;
+  std::string next_cursor;
+  if (const auto it = response.headers.find("X-Next-Cursor");
+      options.pageable && it != response.headers.end()) {
+    next_cursor = it->second;
+  }
+  const bool within_budget = options.max_bytes == 0 || response.body.size() <= options.max_bytes;
+  if (options.compact && within_budget) {
+    stream << response.body << ContinuationNote(next_cursor);
+    return stream.str();
+  }
+
+  auto parsed = TryParseJson(response.body);
+  if (parsed.empty()) {
+    if (within_budget) {
+      stream << response.body;
+    } else {
+      stream << TruncateUtf8(response.body, options.max_bytes) << "\n[truncated: showing "
+             << options.max_bytes << " of " << response.body.size() << " bytes]";
+    }
+    return stream.str();
+  }
+
+  const int indent = options.compact ? -1 : 2;
+  std::string text = parsed.dump(indent);
+  if (options.max_bytes != 0 && text.size() > options.max_bytes) {
+    if (const auto trimmed =
+            TrimToBudget(parsed, indent, options.max_bytes, options.pageable)) {
+      text = parsed.dump(indent);
+      next_cursor = trimmed->cursor;
+      stream << text << "\n[truncated: showing " << trimmed->kept << " of " << trimmed->total
+             << " items]" << ContinuationNote(next_cursor);
+      return stream.str();
+    }
+    stream << TruncateUtf8(text, options.max_bytes) << "\n[truncated: showing "
+           << options.max_bytes << " of " << text.size() << " bytes]";
+    return stream.str();
   }
+  stream << text << ContinuationNote(next_cursor);
   return stream.str();
 }
 
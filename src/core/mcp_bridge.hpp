@@ -1,5 +1,7 @@
 #pragma once
 
+#include <functional>
+#include <map>
 #include <string>
 #include <vector>
 
@@ -16,20 +18,62 @@ struct ToolDefinition {
   nlohmann::json input_schema;
 };
 
+struct DisplayOptions {
+  // Emit JSON as the server sent it (single line) instead of re-indenting it.
+  bool compact = false;
+  // Upper bound on the formatted body; 0 disables it. Oversized JSON keeps whole array items.
+  std::size_t max_bytes = 0;
+  // The response comes from a tool that accepts a `cursor` argument; only then is a cursor for the
+  // last kept item (or the server's X-Next-Cursor) offered as the place to continue from.
+  // CallToolContent sets it from the tool's input schema.
+  bool pageable = false;
+};
+
+// One HTTP-shaped request issued by a tool; the transport decides whether it crosses a socket.
+struct ToolRequest {
+  std::string method;
+  std::string path;
+  std::map<std::string, std::string> query;
+  std::string body;
+  std::string content_type;
+};
+
+using ToolTransport = std::function<platform::HttpClientResponse(const ToolRequest&)>;
+
 class Bridge {
  public:
-  explicit Bridge(std::string base_url);
+  // CallTool may be invoked from several threads; `max_connections` bounds the idle keep-alive
+  // connections kept for them.
+  explicit Bridge(std::string base_url, std::size_t max_connections = 4);
+  // Sends tool requests through `transport`, e.g. straight into an in-process HttpServer.
+  explicit Bridge(ToolTransport transport);
 
   nlohmann::json ToolSchemasJson() const;
   const std::vector<ToolDefinition>& Definitions() const;
 
   platform::HttpClientResponse CallTool(const std::string& name,
                                         const nlohmann::json& arguments) const;
+  // Runs the `params` of a tools/call request and wraps the formatted response as MCP text
+  // content. Throws on unknown tools or invalid arguments.
+  nlohmann::json CallToolContent(const nlohmann::json& params,
+                                 const DisplayOptions& display) const;
 
  private:
-  platform::HttpClient client_;
+  platform::HttpClientResponse Get(const std::string& path,
+                                   const std::map<std::string, std::string>& query = {}) const;
+  platform::HttpClientResponse Post(const std::string& path, const std::string& body,
+                                    const std::map<std::string, std::string>& query = {},
+                                    const std::string& content_type = "application/json") const;
+  platform::HttpClientResponse Patch(const std::string& path, const std::string& body) const;
+
+  ToolTransport transport_;
 };
 
-std::string FormatResponseForDisplay(const platform::HttpClientResponse& response);
+// JSON-RPC 2.0 envelopes shared by the stdio bridge and the server's /mcp endpoint.
+nlohmann::json MakeResultPayload(const nlohmann::json& id, const nlohmann::json& result);
+nlohmann::json MakeErrorPayload(const nlohmann::json& id, int code, const std::string& message);
+
+std::string FormatResponseForDisplay(const platform::HttpClientResponse& response,
+                                     const DisplayOptions& options = {});
 
 }  // namespace core::mcp
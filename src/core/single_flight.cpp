@@ -0,0 +1,99 @@
+#include "core/single_flight.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <exception>
+#include <optional>
+#include <utility>
+
+namespace core {
+
+namespace {
+
+// How often a waiter looks at its client_gone probe; the deadline itself is waited for exactly.
+constexpr auto kWaitSlice = std::chrono::milliseconds(50);
+
+// Blocks until `result` is ready, or throws OperationCancelled once `cancel` fires.
+void AwaitFlight(const std::shared_future<platform::HttpResponse>& result,
+                 const Cancellation& cancel) {
+  if (cancel.deadline == std::chrono::steady_clock::time_point::max() && !cancel.abandoned) {
+    result.wait();
+    return;
+  }
+  for (;;) {
+    const auto until = std::min(std::chrono::steady_clock::now() + kWaitSlice, cancel.deadline);
+    if (result.wait_until(until) == std::future_status::ready) {
+      return;
+    }
+    cancel.ThrowIfCancelled();
+  }
+}
+
+}  // namespace
+
+platform::HttpResponse SingleFlight::Do(const std::string& key, std::uint64_t generation,
+                                        const Compute& compute, const Cancellation& cancel) {
+  for (;;) {
+    std::promise<platform::HttpResponse> promise;
+    std::shared_ptr<Flight> flight;
+    std::shared_future<platform::HttpResponse> joined;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      auto& slot = flights_[key];
+      if (slot && slot->generation >= generation) {
+        joined = slot->result;
+      } else {
+        // No flight, or one that began before a write this caller may already have seen.
+        flight = std::make_shared<Flight>();
+        flight->generation = generation;
+        flight->result = promise.get_future().share();
+        slot = flight;
+      }
+    }
+    if (joined.valid()) {
+      AwaitFlight(joined, cancel);
+      try {
+        auto response = joined.get();
+        coalesced_.fetch_add(1, std::memory_order_relaxed);
+        return response;
+      } catch (const OperationCancelled&) {
+        // The leading request gave up (deadline or disconnect); this one still wants an answer.
+        continue;
+      }
+    }
+    computations_.fetch_add(1, std::memory_order_relaxed);
+
+    std::exception_ptr error;
+    std::optional<platform::HttpResponse> response;
+    try {
+      response = compute();
+    } catch (...) {
+      error = std::current_exception();
+    }
+    {
+      // Removed before publishing, so a waiter that retries never finds this flight again.
+      std::lock_guard<std::mutex> lock(mutex_);
+      // A newer-generation caller may have replaced this flight already; leave theirs in place.
+      if (const auto it = flights_.find(key); it != flights_.end() && it->second == flight) {
+        flights_.erase(it);
+      }
+    }
+    if (error) {
+      promise.set_exception(error);
+      std::rethrow_exception(error);
+    }
+    promise.set_value(*response);
+    return std::move(*response);
+  }
+}
+
+SingleFlightStats SingleFlight::Stats() const {
+  SingleFlightStats stats;
+  stats.computations = computations_.load(std::memory_order_relaxed);
+  stats.coalesced = coalesced_.load(std::memory_order_relaxed);
+  std::lock_guard<std::mutex> lock(mutex_);
+  stats.in_flight = flights_.size();
+  return stats;
+}
+
+}  // namespace core
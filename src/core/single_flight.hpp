@@ -0,0 +1,50 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include "core/checklist_store.hpp"
+#include "platform/http_server.hpp"
+
+namespace core {
+
+struct SingleFlightStats {
+  std::uint64_t computations = 0;  // requests that ran the handler
+  std::uint64_t coalesced = 0;     // requests answered by another request's computation
+  std::size_t in_flight = 0;
+};
+
+// Coalesces concurrent identical reads: callers presenting the same key while a computation for
+// it is running share that computation and each receive a copy of its response (or exception).
+// A caller whose write generation is newer than the running computation's starts a fresh one,
+// so no caller is answered by a read that began before a write it could have observed. When the
+// running computation is cancelled (OperationCancelled), waiting callers run it again themselves.
+// A waiting caller stops waiting with OperationCancelled once its own `cancel` fires; the
+// computation it joined carries on for the others.
+class SingleFlight {
+ public:
+  using Compute = std::function<platform::HttpResponse()>;
+
+  platform::HttpResponse Do(const std::string& key, std::uint64_t generation,
+                            const Compute& compute, const Cancellation& cancel = {});
+  SingleFlightStats Stats() const;
+
+ private:
+  struct Flight {
+    std::uint64_t generation = 0;
+    std::shared_future<platform::HttpResponse> result;
+  };
+
+  mutable std::mutex mutex_;
+  std::unordered_map<std::string, std::shared_ptr<Flight>> flights_;
+  std::atomic<std::uint64_t> computations_{0};
+  std::atomic<std::uint64_t> coalesced_{0};
+};
+
+}  // namespace core
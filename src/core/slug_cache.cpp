@@ -0,0 +1,324 @@
+#include "core/slug_cache.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <mutex>
+
+namespace core {
+namespace {
+
+template <typename T>
+std::size_t VectorBytes(const std::vector<T>& values) {
+  return values.capacity() * sizeof(T);
+}
+
+constexpr std::size_t kMinCompactBytes = 64 * 1024;
+
+}  // namespace
+
+std::uint32_t StringPool::Intern(std::string_view value) {
+  if (const auto it = ids_.find(value); it != ids_.end()) {
+    return it->second;
+  }
+  const std::string_view stored = Store(value);
+  const auto id = static_cast<std::uint32_t>(views_.size());
+  views_.push_back(stored);
+  ids_.emplace(stored, id);
+  return id;
+}
+
+std::uint32_t StringPool::Append(std::string_view value) {
+  const auto id = static_cast<std::uint32_t>(views_.size());
+  views_.push_back(Store(value));
+  return id;
+}
+
+std::string_view StringPool::Store(std::string_view value) {
+  char* data = nullptr;
+  if (value.size() > kBlockSize / 4) {
+    // Large strings get their own allocation so they do not strand the tail of a shared block.
+    oversized_.push_back(std::make_unique<char[]>(value.size()));
+    oversized_bytes_ += value.size();
+    data = oversized_.back().get();
+  } else {
+    if (block_used_ + value.size() > kBlockSize) {
+      blocks_.push_back(std::make_unique<char[]>(kBlockSize));
+      block_used_ = 0;
+    }
+    data = blocks_.back().get() + block_used_;
+    block_used_ += value.size();
+  }
+  std::memcpy(data, value.data(), value.size());
+  return std::string_view(data, value.size());
+}
+
+std::size_t StringPool::ApproxBytes() const {
+  // Hash node (key, value, next, cached hash) plus one bucket pointer per entry.
+  constexpr std::size_t kNodeBytes = sizeof(std::string_view) + 2 * sizeof(void*) + 8;
+  return arena_bytes() + VectorBytes(views_) + ids_.size() * kNodeBytes +
+         ids_.bucket_count() * sizeof(void*);
+}
+
+void StringPool::Clear() {
+  ids_.clear();
+  views_.clear();
+  blocks_.clear();
+  oversized_.clear();
+  block_used_ = kBlockSize;
+  oversized_bytes_ = 0;
+}
+
+ArenaSpan ChecklistColumns::AppendState(std::string_view value) {
+  const ArenaSpan span{static_cast<std::uint32_t>(state_arena.size()),
+                       static_cast<std::uint32_t>(value.size())};
+  state_arena.append(value);
+  return span;
+}
+
+void ChecklistColumns::CompactState() {
+  std::string compacted;
+  compacted.reserve(state_arena.size() - state_garbage);
+  for (auto* column : {&result, &comment, &timestamp}) {
+    for (auto& span : *column) {
+      const auto value = State(span);
+      span.offset = static_cast<std::uint32_t>(compacted.size());
+      compacted.append(value);
+    }
+  }
+  state_arena = std::move(compacted);
+  state_garbage = 0;
+}
+
+void SlugCache::SetEnabled(bool enabled) {
+  std::unique_lock<std::shared_mutex> lock(mutex_);
+  enabled_ = enabled;
+  if (!enabled) {
+    complete_ = false;
+    index_.clear();
+    checklists_.clear();
+    pool_.Clear();
+  }
+}
+
+std::optional<ChecklistSlug> SlugCache::GetSlug(std::string_view address_id) const {
+  std::shared_lock<std::shared_mutex> lock(mutex_);
+  const auto it = index_.find(address_id);
+  if (it == index_.end()) {
+    misses_.fetch_add(1, std::memory_order_relaxed);
+    return std::nullopt;
+  }
+  hits_.fetch_add(1, std::memory_order_relaxed);
+  return Materialize(*it->second.columns, it->second.row);
+}
+
+std::optional<std::vector<ChecklistSlug>> SlugCache::GetChecklist(
+    std::string_view checklist) const {
+  std::shared_lock<std::shared_mutex> lock(mutex_);
+  const auto it = checklists_.find(checklist);
+  if (it == checklists_.end()) {
+    if (!complete_) {
+      misses_.fetch_add(1, std::memory_order_relaxed);
+      return std::nullopt;
+    }
+    hits_.fetch_add(1, std::memory_order_relaxed);
+    return std::vector<ChecklistSlug>{};
+  }
+  hits_.fetch_add(1, std::memory_order_relaxed);
+  std::vector<ChecklistSlug> slugs;
+  MaterializeInto(it->second, slugs);
+  return slugs;
+}
+
+std::optional<std::vector<ChecklistSlug>> SlugCache::ExportAll() const {
+  std::shared_lock<std::shared_mutex> lock(mutex_);
+  if (!complete_) {
+    misses_.fetch_add(1, std::memory_order_relaxed);
+    return std::nullopt;
+  }
+  hits_.fetch_add(1, std::memory_order_relaxed);
+  std::size_t total = 0;
+  for (const auto& [name, columns] : checklists_) {
+    total += columns.rows();
+  }
+  std::vector<ChecklistSlug> slugs;
+  slugs.reserve(total);
+  for (const auto& [name, columns] : checklists_) {
+    MaterializeInto(columns, slugs);
+  }
+  return slugs;
+}
+
+void SlugCache::InstallChecklist(const std::string& checklist,
+                                 const std::vector<ChecklistSlug>& slugs) {
+  std::unique_lock<std::shared_mutex> lock(mutex_);
+  if (!enabled_) {
+    return;
+  }
+  InstallUnlocked(checklist, slugs.data(), slugs.data() + slugs.size());
+}
+
+void SlugCache::InstallAll(const std::vector<ChecklistSlug>& slugs) {
+  std::unique_lock<std::shared_mutex> lock(mutex_);
+  if (!enabled_) {
+    return;
+  }
+  index_.clear();
+  checklists_.clear();
+  pool_.Clear();
+  const ChecklistSlug* begin = slugs.data();
+  const ChecklistSlug* const end = slugs.data() + slugs.size();
+  while (begin != end) {
+    const ChecklistSlug* run = begin;
+    while (run != end && run->checklist == begin->checklist) {
+      ++run;
+    }
+    InstallUnlocked(begin->checklist, begin, run);
+    begin = run;
+  }
+  complete_ = true;
+}
+
+void SlugCache::InstallUnlocked(const std::string& checklist, const ChecklistSlug* begin,
+                                const ChecklistSlug* end) {
+  if (const auto existing = checklists_.find(checklist); existing != checklists_.end()) {
+    for (const auto id : existing->second.address_id) {
+      index_.erase(pool_.View(id));
+    }
+    checklists_.erase(existing);
+  }
+  if (begin == end) {
+    return;
+  }
+
+  ChecklistColumns& columns = checklists_[checklist];
+  const auto rows = static_cast<std::size_t>(end - begin);
+  columns.name = pool_.Intern(checklist);
+  for (auto* column : {&columns.address_id, &columns.section, &columns.procedure,
+                       &columns.action, &columns.spec, &columns.instructions}) {
+    column->reserve(rows);
+  }
+  columns.status.reserve(rows);
+  columns.result.reserve(rows);
+  columns.comment.reserve(rows);
+  columns.timestamp.reserve(rows);
+  columns.edge_begin.reserve(rows + 1);
+  columns.edge_begin.push_back(0);
+
+  for (const ChecklistSlug* slug = begin; slug != end; ++slug) {
+    const auto row = static_cast<std::uint32_t>(columns.rows());
+    const auto address_id = pool_.Append(slug->address_id);
+    columns.address_id.push_back(address_id);
+    columns.section.push_back(pool_.Intern(slug->section));
+    columns.procedure.push_back(pool_.Intern(slug->procedure));
+    columns.action.push_back(pool_.Intern(slug->action));
+    columns.spec.push_back(pool_.Intern(slug->spec));
+    columns.instructions.push_back(pool_.Intern(slug->instructions));
+    columns.status.push_back(slug->status);
+    columns.result.push_back(columns.AppendState(slug->result));
+    columns.comment.push_back(columns.AppendState(slug->comment));
+    columns.timestamp.push_back(columns.AppendState(slug->timestamp));
+    for (const auto& edge : slug->relationships) {
+      columns.edges.emplace_back(pool_.Intern(edge.predicate), pool_.Intern(edge.target));
+    }
+    columns.edge_begin.push_back(static_cast<std::uint32_t>(columns.edges.size()));
+    index_[pool_.View(address_id)] = Location{&columns, row};
+  }
+  columns.edges.shrink_to_fit();
+  columns.state_arena.shrink_to_fit();
+}
+
+void SlugCache::ApplyState(const ChecklistSlug& state) {
+  std::unique_lock<std::shared_mutex> lock(mutex_);
+  const auto it = index_.find(state.address_id);
+  if (it == index_.end()) {
+    return;
+  }
+  ChecklistColumns& columns = *it->second.columns;
+  const auto row = it->second.row;
+  columns.status[row] = state.status;
+  const std::pair<ArenaSpan*, const std::string*> fields[] = {
+      {&columns.result[row], &state.result},
+      {&columns.comment[row], &state.comment},
+      {&columns.timestamp[row], &state.timestamp}};
+  for (const auto& [span, value] : fields) {
+    if (columns.State(*span) == *value) {
+      continue;
+    }
+    columns.state_garbage += span->length;
+    *span = columns.AppendState(*value);
+  }
+  if (columns.state_arena.size() > kMinCompactBytes &&
+      columns.state_garbage * 2 > columns.state_arena.size()) {
+    columns.CompactState();
+  }
+}
+
+void SlugCache::Clear() {
+  std::unique_lock<std::shared_mutex> lock(mutex_);
+  complete_ = false;
+  index_.clear();
+  checklists_.clear();
+  pool_.Clear();
+}
+
+SlugCacheStats SlugCache::Stats() const {
+  std::shared_lock<std::shared_mutex> lock(mutex_);
+  SlugCacheStats stats;
+  stats.enabled = enabled_;
+  stats.complete = complete_;
+  stats.checklists = checklists_.size();
+  stats.interned_strings = pool_.size();
+  stats.hits = hits_.load(std::memory_order_relaxed);
+  stats.misses = misses_.load(std::memory_order_relaxed);
+
+  std::size_t bytes = pool_.ApproxBytes();
+  bytes += index_.size() * (sizeof(std::string_view) + sizeof(Location) + 2 * sizeof(void*)) +
+           index_.bucket_count() * sizeof(void*);
+  for (const auto& [name, columns] : checklists_) {
+    stats.slugs += columns.rows();
+    stats.relationships += columns.edges.size();
+    bytes += sizeof(columns) + name.capacity();
+    bytes += VectorBytes(columns.address_id) + VectorBytes(columns.section) +
+             VectorBytes(columns.procedure) + VectorBytes(columns.action) +
+             VectorBytes(columns.spec) + VectorBytes(columns.instructions) +
+             VectorBytes(columns.status) + VectorBytes(columns.edge_begin) +
+             VectorBytes(columns.edges) + VectorBytes(columns.result) +
+             VectorBytes(columns.comment) + VectorBytes(columns.timestamp) +
+             columns.state_arena.capacity();
+  }
+  stats.approx_bytes = bytes;
+  return stats;
+}
+
+ChecklistSlug SlugCache::Materialize(const ChecklistColumns& columns, std::uint32_t row) const {
+  ChecklistSlug slug;
+  slug.address_id = pool_.View(columns.address_id[row]);
+  slug.checklist = pool_.View(columns.name);
+  slug.section = pool_.View(columns.section[row]);
+  slug.procedure = pool_.View(columns.procedure[row]);
+  slug.action = pool_.View(columns.action[row]);
+  slug.spec = pool_.View(columns.spec[row]);
+  slug.result = columns.State(columns.result[row]);
+  slug.status = columns.status[row];
+  slug.comment = columns.State(columns.comment[row]);
+  slug.timestamp = columns.State(columns.timestamp[row]);
+  slug.instructions = pool_.View(columns.instructions[row]);
+  const auto first = columns.edge_begin[row];
+  const auto last = columns.edge_begin[row + 1];
+  slug.relationships.reserve(last - first);
+  for (auto i = first; i < last; ++i) {
+    slug.relationships.push_back({std::string{pool_.View(columns.edges[i].first)},
+                                  std::string{pool_.View(columns.edges[i].second)}});
+  }
+  return slug;
+}
+
+void SlugCache::MaterializeInto(const ChecklistColumns& columns,
+                                std::vector<ChecklistSlug>& out) const {
+  out.reserve(out.size() + columns.rows());
+  for (std::uint32_t row = 0; row < columns.rows(); ++row) {
+    out.push_back(Materialize(columns, row));
+  }
+}
+
+}  // namespace core
@@ -0,0 +1,123 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <optional>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "core/checklist_store.hpp"
+
+namespace core {
+
+// Append-only string interning. Each distinct string is copied once into large blocks and
+// referred to by a 32-bit id; views stay valid until Clear().
+class StringPool {
+ public:
+  std::uint32_t Intern(std::string_view value);
+  // Stores a string known to be unique (e.g. an Address ID) without a dedupe-table entry.
+  std::uint32_t Append(std::string_view value);
+  std::string_view View(std::uint32_t id) const { return views_[id]; }
+  std::size_t size() const { return views_.size(); }
+  std::size_t arena_bytes() const { return blocks_.size() * kBlockSize + oversized_bytes_; }
+  std::size_t ApproxBytes() const;
+  void Clear();
+
+ private:
+  static constexpr std::size_t kBlockSize = 64 * 1024;
+
+  std::string_view Store(std::string_view value);
+
+  std::vector<std::unique_ptr<char[]>> blocks_;
+  std::vector<std::unique_ptr<char[]>> oversized_;
+  std::size_t block_used_ = kBlockSize;
+  std::size_t oversized_bytes_ = 0;
+  std::vector<std::string_view> views_;
+  std::unordered_map<std::string_view, std::uint32_t> ids_;
+};
+
+// Offset/length of a string inside ChecklistColumns::state_arena.
+struct ArenaSpan {
+  std::uint32_t offset = 0;
+  std::uint32_t length = 0;
+};
+
+// Struct-of-arrays image of one checklist in read-model order (section, procedure, action).
+// Template text is interned. The mutable state columns change on every update, so instead of
+// the shared pool they live in a per-checklist arena that is appended to and compacted once
+// superseded values make up most of it.
+struct ChecklistColumns {
+  std::uint32_t name = 0;
+  std::vector<std::uint32_t> address_id;
+  std::vector<std::uint32_t> section;
+  std::vector<std::uint32_t> procedure;
+  std::vector<std::uint32_t> action;
+  std::vector<std::uint32_t> spec;
+  std::vector<std::uint32_t> instructions;
+  std::vector<ChecklistStatus> status;
+  std::vector<ArenaSpan> result;
+  std::vector<ArenaSpan> comment;
+  std::vector<ArenaSpan> timestamp;
+  std::string state_arena;
+  std::size_t state_garbage = 0;  // arena bytes no longer referenced by any span
+  // Outgoing relationships in CSR form: row i owns edges[edge_begin[i], edge_begin[i + 1]).
+  std::vector<std::uint32_t> edge_begin;
+  std::vector<std::pair<std::uint32_t, std::uint32_t>> edges;  // (predicate, target)
+
+  std::size_t rows() const { return address_id.size(); }
+  std::string_view State(ArenaSpan span) const {
+    return std::string_view(state_arena).substr(span.offset, span.length);
+  }
+  ArenaSpan AppendState(std::string_view value);
+  void CompactState();
+};
+
+// Columnar cache in front of the read model. Readers share a lock and never touch SQLite on a
+// hit. The store fills it from committed data while holding its own mutex, patches state after
+// each committed update, and clears it after structural writes (imports, relationship changes).
+class SlugCache {
+ public:
+  explicit SlugCache(bool enabled = true) : enabled_(enabled) {}
+
+  void SetEnabled(bool enabled);
+  std::optional<ChecklistSlug> GetSlug(std::string_view address_id) const;
+  // nullopt means "not cached"; an empty vector means the checklist is known not to exist.
+  std::optional<std::vector<ChecklistSlug>> GetChecklist(std::string_view checklist) const;
+  std::optional<std::vector<ChecklistSlug>> ExportAll() const;
+
+  // `slugs` must be one checklist (InstallChecklist) or every slug (InstallAll), each in
+  // read-model order and with relationships populated.
+  void InstallChecklist(const std::string& checklist, const std::vector<ChecklistSlug>& slugs);
+  void InstallAll(const std::vector<ChecklistSlug>& slugs);
+  // Copies result/status/comment/timestamp of an updated slug into its cached row, if any.
+  void ApplyState(const ChecklistSlug& state);
+  void Clear();
+  SlugCacheStats Stats() const;
+
+ private:
+  struct Location {
+    ChecklistColumns* columns = nullptr;
+    std::uint32_t row = 0;
+  };
+
+  void InstallUnlocked(const std::string& checklist, const ChecklistSlug* begin,
+                       const ChecklistSlug* end);
+  ChecklistSlug Materialize(const ChecklistColumns& columns, std::uint32_t row) const;
+  void MaterializeInto(const ChecklistColumns& columns, std::vector<ChecklistSlug>& out) const;
+
+  mutable std::shared_mutex mutex_;
+  bool enabled_;
+  bool complete_ = false;  // every checklist in the store is cached
+  StringPool pool_;
+  std::map<std::string, ChecklistColumns, std::less<>> checklists_;
+  std::unordered_map<std::string_view, Location> index_;
+  mutable std::atomic<std::uint64_t> hits_{0};
+  mutable std::atomic<std::uint64_t> misses_{0};
+};
+
+}  // namespace core
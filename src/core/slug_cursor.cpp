@@ -0,0 +1,115 @@
+#include "core/slug_cursor.hpp"
+
+#include <array>
+#include <cstddef>
+#include <string_view>
+
+namespace core {
+
+namespace {
+
+// Versions the encoding; '.' is outside the base64url alphabet and never in an address_id.
+constexpr std::string_view kPrefix = "k1.";
+constexpr std::string_view kAlphabet =
+    "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789-_";
+
+std::string Base64UrlEncode(std::string_view bytes) {
+  std::string out;
+  out.reserve((bytes.size() + 2) / 3 * 4);
+  std::size_t i = 0;
+  for (; i + 2 < bytes.size(); i += 3) {
+    const auto chunk = static_cast<unsigned char>(bytes[i]) << 16 |
+                       static_cast<unsigned char>(bytes[i + 1]) << 8 |
+                       static_cast<unsigned char>(bytes[i + 2]);
+    for (int shift = 18; shift >= 0; shift -= 6) {
+      out.push_back(kAlphabet[(chunk >> shift) & 0x3F]);
+    }
+  }
+  if (const auto rest = bytes.size() - i; rest > 0) {
+    auto chunk = static_cast<unsigned char>(bytes[i]) << 16;
+    if (rest == 2) {
+      chunk |= static_cast<unsigned char>(bytes[i + 1]) << 8;
+    }
+    for (int shift = 18; shift >= 18 - 6 * static_cast<int>(rest); shift -= 6) {
+      out.push_back(kAlphabet[(chunk >> shift) & 0x3F]);
+    }
+  }
+  return out;
+}
+
+std::optional<std::string> Base64UrlDecode(std::string_view text) {
+  if (text.size() % 4 == 1) {
+    return std::nullopt;
+  }
+  std::string out;
+  out.reserve(text.size() * 3 / 4);
+  unsigned int chunk = 0;
+  int bits = 0;
+  for (const char c : text) {
+    const auto value = kAlphabet.find(c);
+    if (value == std::string_view::npos) {
+      return std::nullopt;
+    }
+    chunk = (chunk << 6) | static_cast<unsigned int>(value);
+    bits += 6;
+    if (bits >= 8) {
+      bits -= 8;
+      out.push_back(static_cast<char>((chunk >> bits) & 0xFF));
+    }
+  }
+  return out;
+}
+
+}  // namespace
+
+// Each field is written as "<byte length>:<bytes>", so any byte may appear in a value.
+std::string EncodeSlugCursor(const SlugCursor& cursor) {
+  std::string packed;
+  for (const auto* field : {&cursor.checklist, &cursor.section, &cursor.procedure,
+                            &cursor.action, &cursor.address_id}) {
+    packed += std::to_string(field->size());
+    packed.push_back(':');
+    packed += *field;
+  }
+  return std::string{kPrefix} + Base64UrlEncode(packed);
+}
+
+std::optional<SlugCursor> DecodeSlugCursor(const std::string& text) {
+  if (text.compare(0, kPrefix.size(), kPrefix) != 0) {
+    return std::nullopt;
+  }
+  const auto packed = Base64UrlDecode(std::string_view{text}.substr(kPrefix.size()));
+  if (!packed) {
+    return std::nullopt;
+  }
+  SlugCursor cursor;
+  const std::array<std::string*, 5> fields = {&cursor.checklist, &cursor.section,
+                                              &cursor.procedure, &cursor.action,
+                                              &cursor.address_id};
+  std::size_t at = 0;
+  for (auto* field : fields) {
+    const auto colon = packed->find(':', at);
+    if (colon == std::string::npos || colon == at || colon - at > 9) {
+      return std::nullopt;
+    }
+    std::size_t length = 0;
+    for (std::size_t i = at; i < colon; ++i) {
+      const char digit = (*packed)[i];
+      if (digit < '0' || digit > '9') {
+        return std::nullopt;
+      }
+      length = length * 10 + static_cast<std::size_t>(digit - '0');
+    }
+    if (length > packed->size() - colon - 1) {
+      return std::nullopt;
+    }
+    field->assign(*packed, colon + 1, length);
+    at = colon + 1 + length;
+  }
+  if (at != packed->size()) {
+    return std::nullopt;
+  }
+  return cursor;
+}
+
+}  // namespace core
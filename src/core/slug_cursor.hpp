@@ -0,0 +1,24 @@
+#pragma once
+
+#include <optional>
+#include <string>
+
+namespace core {
+
+// A position in the (checklist, section, procedure, action, address_id) order slug listings
+// page through. It holds the sort key itself, so a page resumes after it even once that slug is
+// gone.
+struct SlugCursor {
+  std::string checklist;
+  std::string section;
+  std::string procedure;
+  std::string action;
+  std::string address_id;
+};
+
+// Opaque, URL-safe text for `cursor=` parameters, `next_cursor` and X-Next-Cursor.
+std::string EncodeSlugCursor(const SlugCursor& cursor);
+// Reverses EncodeSlugCursor; nullopt for any other text, such as a bare address_id.
+std::optional<SlugCursor> DecodeSlugCursor(const std::string& text);
+
+}  // namespace core
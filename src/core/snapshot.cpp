@@ -0,0 +1,276 @@
+#include "core/snapshot.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <ctime>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "core/logging.hpp"
+#include "sqlite3.h"
+
+namespace core {
+namespace {
+
+using core::logging::LogInfo;
+using core::logging::LogWarn;
+
+constexpr char kSnapshotPrefix[] = "checklists-";
+constexpr char kSnapshotSuffix[] = ".db";
+constexpr char kSetAsideSuffix[] = ".pre-restore";
+constexpr char kRestoreMarkerSuffix[] = ".restored-from";
+
+bool IsDefaultSnapshotName(const std::string& name) {
+  const std::string prefix = kSnapshotPrefix;
+  const std::string suffix = kSnapshotSuffix;
+  return name.size() > prefix.size() + suffix.size() && name.rfind(prefix, 0) == 0 &&
+         name.compare(name.size() - suffix.size(), suffix.size(), suffix) == 0;
+}
+
+// Identifies a snapshot file by canonical path, size and modification time.
+std::string SnapshotIdentity(const std::string& snapshot_path) {
+  namespace fs = std::filesystem;
+  const auto path = fs::canonical(snapshot_path);
+  const auto modified = fs::last_write_time(path).time_since_epoch().count();
+  return path.string() + "\n" + std::to_string(fs::file_size(path)) + "\n" +
+         std::to_string(modified) + "\n";
+}
+
+}  // namespace
+
+std::string DefaultSnapshotName() {
+  const std::time_t now = std::time(nullptr);
+  std::tm tm_snapshot{};
+#if defined(_WIN32)
+  gmtime_s(&tm_snapshot, &now);
+#else
+  gmtime_r(&now, &tm_snapshot);
+#endif
+  char buffer[32];
+  std::strftime(buffer, sizeof(buffer), "%Y%m%dT%H%M%SZ", &tm_snapshot);
+  return std::string{kSnapshotPrefix} + buffer + kSnapshotSuffix;
+}
+
+std::string ResolveSnapshotPath(const std::string& directory, const std::string& name) {
+  if (name.empty() || name.size() > 128 || name.front() == '.') {
+    throw std::invalid_argument("Snapshot name must be 1-128 characters and not start with '.'.");
+  }
+  const bool allowed = std::all_of(name.begin(), name.end(), [](unsigned char c) {
+    return std::isalnum(c) || c == '.' || c == '_' || c == '-';
+  });
+  if (!allowed) {
+    throw std::invalid_argument("Snapshot name may only contain letters, digits, '.', '_' or '-'.");
+  }
+  if (name.size() >= 8 && name.compare(name.size() - 8, 8, ".partial") == 0) {
+    throw std::invalid_argument("Snapshot name must not end in '.partial'.");
+  }
+  return (std::filesystem::path(directory) / name).string();
+}
+
+void PruneSnapshots(const std::string& directory, int keep) {
+  namespace fs = std::filesystem;
+  std::error_code ec;
+  std::vector<fs::path> snapshots;
+  for (const auto& entry : fs::directory_iterator(directory, ec)) {
+    if (entry.is_regular_file(ec) && IsDefaultSnapshotName(entry.path().filename().string())) {
+      snapshots.push_back(entry.path());
+    }
+  }
+  if (static_cast<int>(snapshots.size()) <= keep) {
+    return;
+  }
+  // Timestamped names sort chronologically.
+  std::sort(snapshots.begin(), snapshots.end());
+  const auto excess = snapshots.size() - static_cast<std::size_t>(std::max(keep, 0));
+  for (std::size_t i = 0; i < excess; ++i) {
+    if (!fs::remove(snapshots[i], ec) || ec) {
+      LogWarn("Could not prune snapshot " + snapshots[i].string());
+    }
+  }
+}
+
+RestoreResult RestoreSnapshot(const std::string& snapshot_path, const std::string& database_path) {
+  namespace fs = std::filesystem;
+  const auto started = std::chrono::steady_clock::now();
+  if (!fs::is_regular_file(snapshot_path)) {
+    throw std::runtime_error("Snapshot not found: " + snapshot_path);
+  }
+
+  const fs::path target(database_path);
+  if (target.has_parent_path()) {
+    fs::create_directories(target.parent_path());
+  }
+  const fs::path staging = target.string() + ".restore";
+  std::error_code ec;
+  fs::remove(staging, ec);
+
+  sqlite3* source = nullptr;
+  sqlite3* dest = nullptr;
+  sqlite3_backup* backup = nullptr;
+  auto close_all = [&]() {
+    if (backup) {
+      sqlite3_backup_finish(backup);
+      backup = nullptr;
+    }
+    if (dest) {
+      sqlite3_close(dest);
+      dest = nullptr;
+    }
+    if (source) {
+      sqlite3_close(source);
+      source = nullptr;
+    }
+  };
+
+  RestoreResult result;
+  try {
+    if (sqlite3_open_v2(snapshot_path.c_str(), &source, SQLITE_OPEN_READONLY, nullptr) !=
+        SQLITE_OK) {
+      throw std::runtime_error("Cannot open snapshot " + snapshot_path + ": " +
+                               sqlite3_errmsg(source));
+    }
+    sqlite3_stmt* check = nullptr;
+    std::string verdict;
+    if (sqlite3_prepare_v2(source, "PRAGMA quick_check;", -1, &check, nullptr) == SQLITE_OK &&
+        sqlite3_step(check) == SQLITE_ROW) {
+      const unsigned char* text = sqlite3_column_text(check, 0);
+      verdict = text ? reinterpret_cast<const char*>(text) : "";
+    }
+    sqlite3_finalize(check);
+    if (verdict != "ok") {
+      throw std::runtime_error("Snapshot failed integrity check: " +
+                               (verdict.empty() ? std::string{sqlite3_errmsg(source)} : verdict));
+    }
+
+    // Copying through the backup API (rather than the raw file) also folds in any WAL content the
+    // snapshot carries, so the staged file is self-contained.
+    if (sqlite3_open_v2(staging.string().c_str(), &dest,
+                        SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE, nullptr) != SQLITE_OK) {
+      throw std::runtime_error("Cannot create " + staging.string() + ": " + sqlite3_errmsg(dest));
+    }
+    backup = sqlite3_backup_init(dest, "main", source, "main");
+    if (!backup || sqlite3_backup_step(backup, -1) != SQLITE_DONE) {
+      throw std::runtime_error("Snapshot copy failed: " + std::string{sqlite3_errmsg(dest)});
+    }
+    result.pages = sqlite3_backup_pagecount(backup);
+    close_all();
+
+    // The old sidecars must not be replayed onto the restored image, but the old WAL may hold
+    // committed frames, so it is only set aside until the swap has succeeded.
+    std::vector<std::pair<fs::path, fs::path>> set_aside;
+    try {
+      for (const char* suffix : {"-wal", "-shm", "-journal"}) {
+        const fs::path sidecar = target.string() + suffix;
+        if (fs::exists(sidecar)) {
+          const fs::path aside = sidecar.string() + kSetAsideSuffix;
+          fs::rename(sidecar, aside);
+          set_aside.emplace_back(sidecar, aside);
+        }
+      }
+      fs::rename(staging, target);
+    } catch (...) {
+      for (const auto& [sidecar, aside] : set_aside) {
+        fs::rename(aside, sidecar, ec);
+      }
+      throw;
+    }
+    for (const auto& [sidecar, aside] : set_aside) {
+      fs::remove(aside, ec);
+    }
+  } catch (...) {
+    close_all();
+    fs::remove(staging, ec);
+    throw;
+  }
+
+  result.duration = std::chrono::duration_cast<std::chrono::milliseconds>(
+      std::chrono::steady_clock::now() - started);
+  LogInfo("Restored " + database_path + " from " + snapshot_path + " (" +
+          std::to_string(result.pages) + " pages in " + std::to_string(result.duration.count()) +
+          " ms)");
+  return result;
+}
+
+std::optional<RestoreResult> RestoreSnapshotOnce(const std::string& snapshot_path,
+                                                 const std::string& database_path) {
+  namespace fs = std::filesystem;
+  const std::string marker = database_path + kRestoreMarkerSuffix;
+  if (fs::is_regular_file(snapshot_path) && fs::exists(database_path)) {
+    std::ifstream in(marker, std::ios::binary);
+    const std::string applied{std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>()};
+    if (!applied.empty() && applied == SnapshotIdentity(snapshot_path)) {
+      LogInfo("Skipping restore of " + snapshot_path + "; it was already applied to " +
+              database_path + " (remove " + marker + " to restore it again)");
+      return std::nullopt;
+    }
+  }
+
+  const auto result = RestoreSnapshot(snapshot_path, database_path);
+  std::ofstream out(marker, std::ios::binary | std::ios::trunc);
+  out << SnapshotIdentity(snapshot_path);
+  if (!out.flush()) {
+    LogWarn("Could not record restore marker " + marker +
+            "; the snapshot will be restored again on the next start");
+  }
+  return result;
+}
+
+SnapshotScheduler::SnapshotScheduler(const ChecklistStore& store, SnapshotSchedule schedule)
+    : store_(store), schedule_(std::move(schedule)) {}
+
+SnapshotScheduler::~SnapshotScheduler() { Stop(); }
+
+void SnapshotScheduler::Start() {
+  if (schedule_.interval.count() <= 0 || worker_.joinable()) {
+    return;
+  }
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stopping_ = false;
+  }
+  // Copies interrupted by a crash leave `<name>.partial` (plus its journal) behind.
+  namespace fs = std::filesystem;
+  std::error_code ec;
+  for (const auto& entry : fs::directory_iterator(schedule_.directory, ec)) {
+    if (entry.path().filename().string().find(".partial") != std::string::npos) {
+      fs::remove(entry.path(), ec);
+    }
+  }
+  LogInfo("Scheduling snapshots every " + std::to_string(schedule_.interval.count()) +
+          "s into " + schedule_.directory);
+  worker_ = std::thread([this] { Run(); });
+}
+
+void SnapshotScheduler::Stop() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stopping_ = true;
+  }
+  wake_.notify_all();
+  if (worker_.joinable()) {
+    worker_.join();
+  }
+}
+
+void SnapshotScheduler::Run() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  while (!wake_.wait_for(lock, schedule_.interval, [this] { return stopping_; })) {
+    lock.unlock();
+    try {
+      const auto path = ResolveSnapshotPath(schedule_.directory, DefaultSnapshotName());
+      store_.Snapshot(path, schedule_.options);
+      PruneSnapshots(schedule_.directory, schedule_.keep);
+    } catch (const SnapshotBusyError&) {
+      LogInfo("Scheduled snapshot skipped; another snapshot is running");
+    } catch (const std::exception& ex) {
+      LogWarn(std::string{"Scheduled snapshot failed: "} + ex.what());
+    }
+    lock.lock();
+  }
+}
+
+}  // namespace core
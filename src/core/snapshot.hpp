@@ -0,0 +1,69 @@
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+
+#include "core/checklist_store.hpp"
+
+namespace core {
+
+struct SnapshotSchedule {
+  std::string directory;
+  std::chrono::seconds interval{0};  // 0 disables scheduled snapshots
+  int keep = 7;                      // scheduled snapshots retained; older ones are pruned
+  SnapshotOptions options;
+};
+
+// `checklists-YYYYMMDDTHHMMSSZ.db` in UTC; scheduled snapshots and unnamed manual ones use it.
+std::string DefaultSnapshotName();
+// Joins a caller-supplied file name onto `directory`. Names are restricted to [A-Za-z0-9._-] so a
+// request can never escape the snapshot directory.
+std::string ResolveSnapshotPath(const std::string& directory, const std::string& name);
+// Removes all but the newest `keep` default-named snapshots in `directory`.
+void PruneSnapshots(const std::string& directory, int keep);
+
+struct RestoreResult {
+  std::int64_t pages = 0;
+  std::chrono::milliseconds duration{0};
+};
+
+// Replaces the database at `database_path` with the snapshot at `snapshot_path`. Must run before
+// any connection to `database_path` is opened. The snapshot is integrity-checked, copied beside the
+// target, and renamed over it. Stale -wal/-shm/-journal files are renamed aside first so they can
+// never be replayed onto the restored image, and are deleted only once the swap has succeeded.
+// The target and its sidecars are left untouched if any step fails.
+RestoreResult RestoreSnapshot(const std::string& snapshot_path, const std::string& database_path);
+// RestoreSnapshot for startup: records the applied snapshot in `<database_path>.restored-from` and
+// returns nullopt without touching the database when that same snapshot (path, size and mtime)
+// was already restored, so a restart does not discard writes made since.
+std::optional<RestoreResult> RestoreSnapshotOnce(const std::string& snapshot_path,
+                                                 const std::string& database_path);
+
+class SnapshotScheduler {
+ public:
+  SnapshotScheduler(const ChecklistStore& store, SnapshotSchedule schedule);
+  ~SnapshotScheduler();
+
+  SnapshotScheduler(const SnapshotScheduler&) = delete;
+  SnapshotScheduler& operator=(const SnapshotScheduler&) = delete;
+
+  void Start();
+  void Stop();
+
+ private:
+  void Run();
+
+  const ChecklistStore& store_;
+  SnapshotSchedule schedule_;
+  std::thread worker_;
+  std::mutex mutex_;
+  std::condition_variable wake_;
+  bool stopping_ = false;
+};
+
+}  // namespace core
@@ -0,0 +1,30 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+namespace core {
+
+// SQLite connection tuning applied by ChecklistStore::Initialize. Defaults match "durable", which
+// keeps SQLite's own crash-durability (synchronous=FULL, no mmap); the faster presets are opt-in.
+struct StorageSettings {
+  std::string profile = "durable";
+  std::string synchronous = "FULL";  // OFF, NORMAL, FULL, EXTRA
+  std::int64_t cache_size_kib = 8 * 1024;
+  std::int64_t mmap_size_bytes = 0;
+  std::string temp_store = "DEFAULT";  // DEFAULT, FILE, MEMORY
+  int wal_autocheckpoint_pages = 1000;
+  int busy_timeout_ms = 5000;
+};
+
+// Named presets:
+//   durable    - (default) synchronous=FULL, small cache, no mmap: every commit survives power
+//                loss.
+//   balanced   - synchronous=NORMAL (WAL-safe; a power cut may drop the last commits), 64 MiB cache,
+//                256 MiB mmap.
+//   throughput - synchronous=OFF, 256 MiB cache, 1 GiB mmap, lazier checkpoints; an OS crash can
+//                lose recent commits, so pair it with snapshots.
+// Throws std::invalid_argument for any other name.
+StorageSettings StorageProfile(const std::string& name);
+
+}  // namespace core
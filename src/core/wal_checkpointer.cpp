@@ -0,0 +1,166 @@
+#include "core/wal_checkpointer.hpp"
+
+#include <algorithm>
+#include <filesystem>
+#include <stdexcept>
+#include <utility>
+
+#include "core/logging.hpp"
+#include "sqlite3.h"
+
+namespace core {
+namespace {
+
+using core::logging::LogInfo;
+using core::logging::LogWarn;
+
+}  // namespace
+
+WalCheckpointer::WalCheckpointer(std::string db_path, WalCheckpointPolicy policy)
+    : db_path_(std::move(db_path)), policy_(policy) {
+  policy_.wal_pages_threshold = std::max(policy_.wal_pages_threshold, 1);
+  wake_at_pages_ = policy_.wal_pages_threshold;
+}
+
+WalCheckpointer::~WalCheckpointer() { Stop(); }
+
+void WalCheckpointer::Start() {
+  if (worker_.joinable()) {
+    return;
+  }
+  const int rc = sqlite3_open_v2(db_path_.c_str(), &db_, SQLITE_OPEN_READWRITE, nullptr);
+  if (rc != SQLITE_OK) {
+    const std::string message = db_ ? sqlite3_errmsg(db_) : sqlite3_errstr(rc);
+    sqlite3_close(db_);
+    db_ = nullptr;
+    throw std::runtime_error("Failed to open checkpoint connection: " + message);
+  }
+  // A fresh connection only learns the file is in WAL mode once it reads it; until then every
+  // checkpoint is a silent no-op reporting -1 frames.
+  char* errmsg = nullptr;
+  sqlite3_exec(db_, "PRAGMA journal_mode=WAL;", nullptr, nullptr, &errmsg);
+  if (errmsg) {
+    const std::string message = errmsg;
+    sqlite3_free(errmsg);
+    sqlite3_close(db_);
+    db_ = nullptr;
+    throw std::runtime_error("Failed to attach checkpoint connection to the WAL: " + message);
+  }
+  // Fail fast instead of queueing behind writers; a busy checkpoint is simply retried later.
+  sqlite3_busy_timeout(db_, 0);
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stopping_ = false;
+  }
+  worker_ = std::thread([this] { Run(); });
+  LogInfo("WAL checkpointer started (interval " + std::to_string(policy_.interval.count()) +
+          " ms, threshold " + std::to_string(policy_.wal_pages_threshold) + " pages)");
+}
+
+void WalCheckpointer::Stop() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stopping_ = true;
+  }
+  wake_.notify_all();
+  if (worker_.joinable()) {
+    worker_.join();
+  }
+  if (db_) {
+    sqlite3_close(db_);
+    db_ = nullptr;
+  }
+}
+
+void WalCheckpointer::NotifyCommit(int wal_pages) {
+  bool wake = false;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    dirty_ = true;
+    truncated_ = false;
+    wal_pages_ = wal_pages;
+    last_commit_ = std::chrono::steady_clock::now();
+    wake = wal_pages >= wake_at_pages_;
+  }
+  {
+    std::lock_guard<std::mutex> lock(stats_mutex_);
+    ++stats_.commits_observed;
+  }
+  if (wake) {
+    wake_.notify_one();
+  }
+}
+
+WalCheckpointStats WalCheckpointer::Stats() const {
+  std::lock_guard<std::mutex> lock(stats_mutex_);
+  return stats_;
+}
+
+void WalCheckpointer::Run() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  while (!stopping_) {
+    wake_.wait_for(lock, policy_.interval,
+                   [this] { return stopping_ || (dirty_ && wal_pages_ >= wake_at_pages_); });
+    if (stopping_) {
+      break;
+    }
+
+    const auto idle_for = std::chrono::steady_clock::now() - last_commit_;
+    if (dirty_) {
+      dirty_ = false;
+      lock.unlock();
+      const bool complete = Checkpoint(SQLITE_CHECKPOINT_PASSIVE);
+      lock.lock();
+      // Frames pinned by readers stay in the WAL; retry them next round, and only wake early
+      // again once the WAL has grown by another threshold beyond what is stuck there.
+      dirty_ = dirty_ || !complete;
+      wake_at_pages_ = policy_.wal_pages_threshold + (complete ? 0 : wal_pages_);
+    } else if (!truncated_ && policy_.truncate_after_idle.count() > 0 &&
+               idle_for >= policy_.truncate_after_idle) {
+      lock.unlock();
+      const bool complete = Checkpoint(SQLITE_CHECKPOINT_TRUNCATE);
+      lock.lock();
+      truncated_ = truncated_ || complete;
+      if (complete) {
+        wake_at_pages_ = policy_.wal_pages_threshold;
+      }
+    }
+  }
+}
+
+bool WalCheckpointer::Checkpoint(int mode) {
+  const auto started = std::chrono::steady_clock::now();
+  int log_frames = -1;
+  int checkpointed = -1;
+  const int rc = sqlite3_wal_checkpoint_v2(db_, nullptr, mode, &log_frames, &checkpointed);
+  const auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(
+      std::chrono::steady_clock::now() - started);
+
+  std::error_code ec;
+  const auto wal_size = std::filesystem::file_size(db_path_ + "-wal", ec);
+
+  std::lock_guard<std::mutex> lock(stats_mutex_);
+  if (mode == SQLITE_CHECKPOINT_TRUNCATE) {
+    ++stats_.truncate_runs;
+  } else {
+    ++stats_.passive_runs;
+  }
+  stats_.last_duration = elapsed;
+  stats_.max_duration = std::max(stats_.max_duration, elapsed);
+  stats_.total_duration += elapsed;
+  stats_.last_wal_frames = log_frames;
+  stats_.last_checkpointed_frames = checkpointed;
+  stats_.wal_bytes = ec ? 0 : static_cast<std::int64_t>(wal_size);
+
+  if (rc == SQLITE_BUSY || (rc == SQLITE_OK && checkpointed < log_frames)) {
+    ++stats_.busy_runs;
+    return false;
+  }
+  if (rc != SQLITE_OK) {
+    LogWarn(std::string{"WAL checkpoint failed: "} + sqlite3_errstr(rc));
+    return false;
+  }
+  return true;
+}
+
+}  // namespace core
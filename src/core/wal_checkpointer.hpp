@@ -0,0 +1,73 @@
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+
+struct sqlite3;
+
+namespace core {
+
+struct WalCheckpointPolicy {
+  std::chrono::milliseconds interval{1000};  // passive checkpoint cadence while commits arrive
+  int wal_pages_threshold = 1000;            // WAL growth that wakes the thread early
+  std::chrono::milliseconds truncate_after_idle{30000};  // 0 never truncates
+};
+
+struct WalCheckpointStats {
+  std::uint64_t commits_observed = 0;
+  std::uint64_t passive_runs = 0;
+  std::uint64_t truncate_runs = 0;
+  std::uint64_t busy_runs = 0;  // checkpoints that could not finish because of readers/writers
+  std::chrono::microseconds last_duration{0};
+  std::chrono::microseconds max_duration{0};
+  std::chrono::microseconds total_duration{0};
+  int last_wal_frames = 0;
+  int last_checkpointed_frames = 0;
+  std::int64_t wal_bytes = 0;
+};
+
+// Runs WAL checkpoints on a dedicated connection so request threads never pay for one. The store's
+// connection reports each commit through NotifyCommit (from sqlite3_wal_hook, which also disables
+// SQLite's inline autocheckpoint); the worker runs PASSIVE checkpoints on the time/size policy and
+// a TRUNCATE once writes have been idle long enough to shrink the -wal file back to zero.
+class WalCheckpointer {
+ public:
+  WalCheckpointer(std::string db_path, WalCheckpointPolicy policy);
+  ~WalCheckpointer();
+
+  WalCheckpointer(const WalCheckpointer&) = delete;
+  WalCheckpointer& operator=(const WalCheckpointer&) = delete;
+
+  void Start();
+  void Stop();
+  // Called on the committing thread with the WAL size in frames; only records and signals.
+  void NotifyCommit(int wal_pages);
+  WalCheckpointStats Stats() const;
+
+ private:
+  void Run();
+  bool Checkpoint(int mode);
+
+  std::string db_path_;
+  WalCheckpointPolicy policy_;
+  sqlite3* db_ = nullptr;
+  std::thread worker_;
+
+  std::mutex mutex_;
+  std::condition_variable wake_;
+  bool stopping_ = false;
+  bool dirty_ = false;          // commits since the last complete checkpoint
+  bool truncated_ = true;       // WAL already truncated since the last commit
+  int wal_pages_ = 0;
+  int wake_at_pages_ = 0;
+  std::chrono::steady_clock::time_point last_commit_{};
+
+  mutable std::mutex stats_mutex_;
+  WalCheckpointStats stats_;
+};
+
+}  // namespace core
@@ -35,6 +35,14 @@ ParsedUrl ParseUrl(const std::string& base_url) {
 
   parsed.scheme = base_url.substr(0, scheme_end);
   auto remainder = base_url.substr(scheme_end + 3);
+  if (parsed.scheme == "unix") {
+    // The whole remainder is the socket path: unix:///run/apim.sock -> /run/apim.sock.
+    if (remainder.empty()) {
+      throw std::invalid_argument("Unix socket URL must name a path (e.g., unix:///run/apim.sock)");
+    }
+    parsed.host = remainder;
+    return parsed;
+  }
   const auto slash_pos = remainder.find('/');
   if (slash_pos != std::string::npos) {
     remainder = remainder.substr(0, slash_pos);
@@ -75,61 +83,109 @@ std::string UrlEncode(const std::string& value) {
 
 namespace platform {
 
-HttpClient::HttpClient(std::string base_url) {
+HttpClient::HttpClient(std::string base_url, std::size_t max_idle_connections)
+    : max_idle_connections_(max_idle_connections) {
   auto parsed = ParseUrl(base_url);
   scheme_ = std::move(parsed.scheme);
   host_ = std::move(parsed.host);
   port_ = parsed.port;
-  if (scheme_ != "http") {
-    throw std::invalid_argument("Only http:// URLs are supported for the MCP client bridge");
+  if (scheme_ != "http" && scheme_ != "unix") {
+    throw std::invalid_argument(
+        "Only http:// and unix:// URLs are supported for the MCP client bridge");
+  }
+#ifdef _WIN32
+  if (scheme_ == "unix") {
+    throw std::invalid_argument("unix:// URLs are not supported on this platform");
   }
+#endif
 }
 
+HttpClient::~HttpClient() = default;
+
 HttpClientResponse HttpClient::Get(const std::string& path,
                                    const std::map<std::string, std::string>& query) const {
-  httplib::Client client(host_.c_str(), port_);
-  client.set_connection_timeout(timeout_seconds_);
-  client.set_read_timeout(timeout_seconds_);
-  client.set_write_timeout(timeout_seconds_);
-
   const auto target = BuildTarget(path, query);
-  auto response = client.Get(target.c_str());
-  if (!response) {
-    Raise(target);
-  }
-  return ConvertResponse(*response);
+  return Send(target, /*idempotent=*/true,
+              [&](httplib::Client& client) { return client.Get(target.c_str()); });
 }
 
 HttpClientResponse HttpClient::Post(const std::string& path, const std::string& body,
                                     const std::map<std::string, std::string>& query,
                                     const std::string& content_type) const {
-  httplib::Client client(host_.c_str(), port_);
-  client.set_connection_timeout(timeout_seconds_);
-  client.set_read_timeout(timeout_seconds_);
-  client.set_write_timeout(timeout_seconds_);
-
   const auto target = BuildTarget(path, query);
-  auto response = client.Post(target.c_str(), body, content_type.c_str());
-  if (!response) {
-    Raise(target);
-  }
-  return ConvertResponse(*response);
+  return Send(target, /*idempotent=*/false, [&](httplib::Client& client) {
+    return client.Post(target.c_str(), body, content_type.c_str());
+  });
 }
 
 HttpClientResponse HttpClient::Patch(const std::string& path, const std::string& body,
                                      const std::map<std::string, std::string>& query,
                                      const std::string& content_type) const {
-  httplib::Client client(host_.c_str(), port_);
-  client.set_connection_timeout(timeout_seconds_);
-  client.set_read_timeout(timeout_seconds_);
-  client.set_write_timeout(timeout_seconds_);
-
   const auto target = BuildTarget(path, query);
-  auto response = client.Patch(target.c_str(), body, content_type.c_str());
-  if (!response) {
-    Raise(target);
+  return Send(target, /*idempotent=*/false, [&](httplib::Client& client) {
+    return client.Patch(target.c_str(), body, content_type.c_str());
+  });
+}
+
+std::uint64_t HttpClient::ConnectionsOpened() const {
+  return connections_opened_.load(std::memory_order_relaxed);
+}
+
+std::unique_ptr<httplib::Client> HttpClient::Acquire() const {
+  {
+    std::lock_guard<std::mutex> lock(pool_mutex_);
+    if (!idle_.empty()) {
+      auto client = std::move(idle_.back());
+      idle_.pop_back();
+      return client;
+    }
+  }
+  auto client = std::make_unique<httplib::Client>(host_, port_);
+  client->set_keep_alive(true);
+  if (scheme_ == "unix") {
+#ifndef _WIN32
+    client->set_address_family(AF_UNIX);
+#endif
+  } else {
+    client->set_tcp_nodelay(true);
+  }
+  client->set_connection_timeout(timeout_seconds_);
+  client->set_read_timeout(timeout_seconds_);
+  client->set_write_timeout(timeout_seconds_);
+  return client;
+}
+
+void HttpClient::Release(std::unique_ptr<httplib::Client> client) const {
+  std::lock_guard<std::mutex> lock(pool_mutex_);
+  if (idle_.size() < max_idle_connections_) {
+    idle_.push_back(std::move(client));
+  }
+}
+
+template <typename SendRequest>
+HttpClientResponse HttpClient::Send(const std::string& target, bool idempotent,
+                                    SendRequest&& send) const {
+  for (int attempt = 0;; ++attempt) {
+    auto client = Acquire();
+    // httplib drops a pooled socket the server has already closed and reconnects on its own;
+    // what remains is the race where the server closes it while the request is in flight.
+    const bool reused = client->is_socket_open() != 0;
+    if (!reused) {
+      connections_opened_.fetch_add(1, std::memory_order_relaxed);
+    }
+    auto result = send(*client);
+    if (result) {
+      auto response = ConvertResponse(*result);
+      Release(std::move(client));
+      return response;
+    }
+    const auto error = result.error();
+    const bool unsent =
+        error == httplib::Error::Connection || error == httplib::Error::Write;
+    if (attempt > 0 || !reused || !(idempotent || unsent)) {
+      Raise(target);
+    }
   }
-  return ConvertResponse(*response);
 }
 
 std::string HttpClient::BuildTarget(const std::string& path,
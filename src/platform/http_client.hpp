@@ -1,9 +1,15 @@
 #pragma once
 
+#include <atomic>
+#include <cstdint>
 #include <map>
+#include <memory>
+#include <mutex>
 #include <string>
+#include <vector>
 
 namespace httplib {
+class Client;
 class Response;
 }
 
@@ -16,9 +22,18 @@ struct HttpClientResponse {
   std::map<std::string, std::string> headers;
 };
 
+// Keeps up to `max_idle_connections` keep-alive connections for reuse; safe to share between
+// threads (each request checks a connection out of the pool for its duration). A request that
+// fails on a reused connection the server has since dropped is retried once on a new connection
+// when it is safe to: always for GET, and for POST/PATCH only if the request was never sent.
+// `base_url` is http://host:port, or unix:///path/to.sock for a server's Unix domain socket.
 class HttpClient {
  public:
-  explicit HttpClient(std::string base_url);
+  explicit HttpClient(std::string base_url, std::size_t max_idle_connections = 4);
+  ~HttpClient();
+
+  HttpClient(const HttpClient&) = delete;
+  HttpClient& operator=(const HttpClient&) = delete;
 
   HttpClientResponse Get(const std::string& path,
                          const std::map<std::string, std::string>& query = {}) const;
@@ -29,7 +44,14 @@ class HttpClient {
                            const std::map<std::string, std::string>& query = {},
                            const std::string& content_type = "application/json") const;
 
+  // Connections opened so far; stays flat while requests reuse pooled connections.
+  std::uint64_t ConnectionsOpened() const;
+
  private:
+  std::unique_ptr<httplib::Client> Acquire() const;
+  void Release(std::unique_ptr<httplib::Client> client) const;
+  template <typename SendRequest>
+  HttpClientResponse Send(const std::string& target, bool idempotent, SendRequest&& send) const;
   std::string BuildTarget(const std::string& path,
                           const std::map<std::string, std::string>& query) const;
   HttpClientResponse ConvertResponse(const httplib::Response& response) const;
@@ -39,6 +61,10 @@ class HttpClient {
   std::string host_;
   int port_;
   int timeout_seconds_ = 5;
+  std::size_t max_idle_connections_;
+  mutable std::mutex pool_mutex_;
+  mutable std::vector<std::unique_ptr<httplib::Client>> idle_;
+  mutable std::atomic<std::uint64_t> connections_opened_{0};
 };
 
 }  // namespace platform
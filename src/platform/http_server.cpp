@@ -1,26 +1,298 @@
 #include "platform/http_server.hpp"
 
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
 #include <mutex>
+#include <optional>
+#include <regex>
 #include <stdexcept>
 #include <string>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
 #include <utility>
+#include <vector>
 
 #include "httplib.h"
 
+#ifndef _WIN32
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
 namespace platform {
+namespace {
 
-class HttpServer::Impl {
+constexpr std::size_t kKeepAliveMaxRequests = 1000;
+constexpr std::size_t kMethodCount = 4;
+constexpr std::string_view kRegexSyntax = "()[]{}*+?.^$|\\";
+constexpr const char* kRequestTimeoutHeader = "X-Request-Timeout-Ms";
+// Past this many buckets, idle (refilled) ones are dropped; they are the same as new ones.
+constexpr std::size_t kMaxIdleBuckets = 4096;
+
+struct Route {
+  enum class Kind { kExact, kPrefix, kRegex };
+
+  Kind kind;
+  std::string path;          // full path (kExact) or the literal prefix ending in '/' (kPrefix)
+  bool capture_rest = false;  // kPrefix: pass the non-empty remainder as the path parameter
+  std::regex pattern;         // kRegex only
+  RouteClass route_class = RouteClass::kRead;
+  HttpHandler handler;
+  HttpStreamingHandler streaming_handler;
+};
+
+struct TransparentHash {
+  using is_transparent = void;
+  std::size_t operator()(std::string_view value) const {
+    return std::hash<std::string_view>{}(value);
+  }
+};
+
+struct RouteMatch {
+  const Route* route = nullptr;
+  std::vector<std::string> path_params;
+};
+
+// Per-method routing: an exact-path hash map, a table of '/'-terminated prefixes probed at each
+// '/' of the request path from the longest down (a segment trie flattened into one hash map),
+// and a regex list kept only for patterns that fit neither shape.
+class Router {
  public:
-  httplib::Server server;
-  std::mutex lifecycle_mutex;
-  bool running = false;
+  // "/api/x" is exact; "/api/x/(.+)" captures the non-empty rest and "/api/x/.*" matches any
+  // rest without capturing; any other pattern is treated as a regex.
+  void Add(HttpMethod method, const std::string& pattern, HttpHandler handler,
+           HttpStreamingHandler streaming_handler, std::optional<RouteClass> route_class) {
+    Route route;
+    route.route_class = route_class.value_or(
+        method == HttpMethod::kPost || method == HttpMethod::kPatch ? RouteClass::kWrite
+                                                                    : RouteClass::kRead);
+    route.handler = std::move(handler);
+    route.streaming_handler = std::move(streaming_handler);
+    auto& table = tables_[static_cast<std::size_t>(method)];
+
+    if (pattern.find_first_of(kRegexSyntax) == std::string::npos) {
+      route.kind = Route::Kind::kExact;
+      route.path = pattern;
+      table.exact.try_emplace(pattern, std::move(route));
+      return;
+    }
+    for (const auto& [suffix, capture] : {std::pair{std::string_view{"(.+)"}, true},
+                                          std::pair{std::string_view{".*"}, false}}) {
+      if (pattern.size() <= suffix.size() ||
+          pattern.compare(pattern.size() - suffix.size(), suffix.size(), suffix) != 0) {
+        continue;
+      }
+      const auto prefix = pattern.substr(0, pattern.size() - suffix.size());
+      if (prefix.back() == '/' && prefix.find_first_of(kRegexSyntax) == std::string::npos) {
+        route.kind = Route::Kind::kPrefix;
+        route.path = prefix;
+        route.capture_rest = capture;
+        table.prefixes.try_emplace(prefix, std::move(route));
+        return;
+      }
+    }
+    route.kind = Route::Kind::kRegex;
+    route.path = pattern;
+    route.pattern = std::regex(pattern);
+    table.regexes.push_back(std::move(route));
+  }
+
+  bool Find(HttpMethod method, const std::string& path, RouteMatch& match) const {
+    const auto& table = tables_[static_cast<std::size_t>(method)];
+    if (const auto it = table.exact.find(path); it != table.exact.end()) {
+      match.route = &it->second;
+      return true;
+    }
+    if (!table.prefixes.empty()) {
+      const std::string_view view{path};
+      for (auto slash = view.rfind('/'); slash != std::string_view::npos;
+           slash = slash == 0 ? std::string_view::npos : view.rfind('/', slash - 1)) {
+        const auto it = table.prefixes.find(view.substr(0, slash + 1));
+        if (it == table.prefixes.end()) {
+          continue;
+        }
+        const auto rest = view.substr(slash + 1);
+        if (it->second.capture_rest) {
+          if (rest.empty()) {
+            continue;
+          }
+          match.path_params.emplace_back(rest);
+        }
+        match.route = &it->second;
+        return true;
+      }
+    }
+    for (const auto& route : table.regexes) {
+      std::smatch matches;
+      if (std::regex_match(path, matches, route.pattern)) {
+        for (std::size_t i = 1; i < matches.size(); ++i) {
+          match.path_params.push_back(matches[i].str());
+        }
+        match.route = &route;
+        return true;
+      }
+    }
+    return false;
+  }
+
+  // True when some method other than OPTIONS routes `path`; preflight is answered only for those.
+  bool Routes(const std::string& path) const {
+    RouteMatch ignored;
+    for (const auto method : {HttpMethod::kGet, HttpMethod::kPost, HttpMethod::kPatch}) {
+      if (Find(method, path, ignored)) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+ private:
+  struct Table {
+    std::unordered_map<std::string, Route, TransparentHash, std::equal_to<>> exact;
+    std::unordered_map<std::string, Route, TransparentHash, std::equal_to<>> prefixes;
+    std::vector<Route> regexes;
+  };
+
+  Table tables_[kMethodCount];
 };
 
-namespace {
+// Token buckets keyed by client and route class, and the concurrency cap for heavy routes.
+class AdmissionControl {
+ public:
+  using Clock = std::chrono::steady_clock;
 
-HttpRequest ConvertRequest(const httplib::Request& req) {
+  // Holds one heavy-route slot until destroyed.
+  class Ticket {
+   public:
+    Ticket() = default;
+    Ticket(const Ticket&) = delete;
+    Ticket& operator=(const Ticket&) = delete;
+    ~Ticket() {
+      if (in_flight_) {
+        in_flight_->fetch_sub(1, std::memory_order_relaxed);
+      }
+    }
+
+   private:
+    friend class AdmissionControl;
+    std::atomic<int>* in_flight_ = nullptr;
+  };
+
+  void SetPolicy(AdmissionPolicy policy) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    policy_ = std::move(policy);
+    buckets_.clear();
+  }
+
+  // Returns a 429 response when `client` may not run a `route_class` request now; otherwise
+  // admits it, with `ticket` holding its heavy slot. An empty `client` skips the rate buckets.
+  std::optional<HttpResponse> Admit(const std::string& client, RouteClass route_class,
+                                    Ticket& ticket) {
+    if (route_class == RouteClass::kUncharged) {
+      return std::nullopt;
+    }
+    const auto index = static_cast<std::size_t>(route_class);
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (route_class == RouteClass::kHeavy && policy_.max_concurrent_heavy > 0) {
+      if (heavy_in_flight_.load(std::memory_order_relaxed) >= policy_.max_concurrent_heavy) {
+        ++stats_.concurrency_limited;
+        return Reject(1);
+      }
+    }
+    const RateLimit& limit = LimitFor(index);
+    if (limit.per_second > 0 && !client.empty()) {
+      const auto now = Clock::now();
+      const double burst = std::max(limit.burst, 1.0);
+      std::string key = client;
+      key.push_back(static_cast<char>('0' + index));
+      auto [it, inserted] = buckets_.try_emplace(std::move(key), Bucket{burst, now});
+      auto& bucket = it->second;
+      Refill(bucket, limit, burst, now);
+      if (bucket.tokens < 1) {
+        ++stats_.rate_limited[index];
+        return Reject(std::ceil((1 - bucket.tokens) / limit.per_second));
+      }
+      bucket.tokens -= 1;
+      if (inserted && buckets_.size() > kMaxIdleBuckets) {
+        DropIdleBuckets(now);
+      }
+    }
+    ++stats_.admitted[index];
+    if (route_class == RouteClass::kHeavy) {
+      heavy_in_flight_.fetch_add(1, std::memory_order_relaxed);
+      ticket.in_flight_ = &heavy_in_flight_;
+    }
+    return std::nullopt;
+  }
+
+  AdmissionStats Stats() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    AdmissionStats stats = stats_;
+    stats.heavy_in_flight = heavy_in_flight_.load(std::memory_order_relaxed);
+    return stats;
+  }
+
+ private:
+  struct Bucket {
+    double tokens;
+    Clock::time_point updated;
+  };
+
+  const RateLimit& LimitFor(std::size_t index) const {
+    return index == 0 ? policy_.read : index == 1 ? policy_.write : policy_.heavy;
+  }
+
+  static void Refill(Bucket& bucket, const RateLimit& limit, double burst, Clock::time_point now) {
+    const std::chrono::duration<double> elapsed = now - bucket.updated;
+    bucket.tokens = std::min(burst, bucket.tokens + elapsed.count() * limit.per_second);
+    bucket.updated = now;
+  }
+
+  void DropIdleBuckets(Clock::time_point now) {
+    for (auto it = buckets_.begin(); it != buckets_.end();) {
+      const auto index = static_cast<std::size_t>(it->first.back() - '0');
+      const RateLimit& limit = LimitFor(index);
+      const double burst = std::max(limit.burst, 1.0);
+      Refill(it->second, limit, burst, now);
+      it = it->second.tokens >= burst ? buckets_.erase(it) : std::next(it);
+    }
+  }
+
+  HttpResponse Reject(double retry_after_seconds) const {
+    HttpResponse response;
+    response.status = 429;
+    response.body = "{\"error\":\"Too many requests; retry later.\"}";
+    response.headers = policy_.rejection_headers;
+    response.headers["Retry-After"] =
+        std::to_string(std::max<long long>(1, static_cast<long long>(retry_after_seconds)));
+    return response;
+  }
+
+  mutable std::mutex mutex_;
+  AdmissionPolicy policy_;
+  std::unordered_map<std::string, Bucket> buckets_;
+  AdmissionStats stats_;
+  std::atomic<int> heavy_in_flight_{0};
+};
+
+// Converts a request arriving over a socket; `req` must outlive the result's client_gone probe.
+HttpRequest ConvertRequest(const httplib::Request& req, std::chrono::milliseconds timeout,
+                           bool unix_socket) {
   HttpRequest request;
   request.path = req.path;
+  if (!unix_socket) {
+    request.client = req.remote_addr;
+  }
   request.body = req.body;
   for (const auto& param : req.params) {
     request.query_params[param.first] = param.second;
@@ -28,67 +300,285 @@ HttpRequest ConvertRequest(const httplib::Request& req) {
   for (const auto& header : req.headers) {
     request.headers[header.first] = header.second;
   }
-  if (!req.matches.empty()) {
-    for (std::size_t i = 1; i < req.matches.size(); ++i) {
-      request.path_params.emplace_back(req.matches[i]);
+  request.client_gone = [&req] { return req.is_connection_closed(); };
+  if (const auto it = req.headers.find(kRequestTimeoutHeader); it != req.headers.end()) {
+    char* end = nullptr;
+    const long long requested = std::strtoll(it->second.c_str(), &end, 10);
+    if (end != it->second.c_str() && *end == '\0' && requested > 0 &&
+        (timeout.count() == 0 || requested < timeout.count())) {
+      timeout = std::chrono::milliseconds(requested);
     }
   }
+  if (timeout.count() > 0) {
+    request.deadline = std::chrono::steady_clock::now() + timeout;
+  }
   return request;
 }
 
-httplib::Server::Handler WrapHandler(HttpHandler handler) {
-  return [handler = std::move(handler)](const httplib::Request& req,
-                                        httplib::Response& res) {
-    try {
-      const HttpRequest request = ConvertRequest(req);
-      HttpResponse response = handler(request);
-      if (response.content_type.empty()) {
-        response.content_type = "text/plain";
+void WriteResponse(HttpResponse response, httplib::Response& res) {
+  if (response.content_type.empty()) {
+    response.content_type = "text/plain";
+  }
+  for (const auto& header : response.headers) {
+    res.set_header(header.first.c_str(), header.second.c_str());
+  }
+  res.status = response.status;
+  res.set_content(response.body, response.content_type);
+}
+
+HttpResponse ServerErrorResponse(const std::string& body) {
+  HttpResponse response;
+  response.status = 500;
+  response.body = body;
+  return response;
+}
+
+HttpResponse BadRequestResponse(const std::string& body) {
+  HttpResponse response;
+  response.status = 400;
+  response.body = body;
+  return response;
+}
+
+HttpResponse NotFoundResponse() {
+  HttpResponse response;
+  response.status = 404;
+  response.content_type = "text/plain";
+  return response;
+}
+
+template <typename Invoke>
+HttpResponse Guarded(Invoke&& invoke) {
+  try {
+    return invoke();
+  } catch (const std::exception& ex) {
+    return ServerErrorResponse(std::string{"{\"error\":\""} + ex.what() + "\"}");
+  } catch (...) {
+    return ServerErrorResponse("{\"error\":\"Unhandled server error\"}");
+  }
+}
+
+// Owner and group may connect; access to the Unix socket is governed by these bits.
+constexpr auto kUnixSocketPermissions =
+    std::filesystem::perms::owner_read | std::filesystem::perms::owner_write |
+    std::filesystem::perms::group_read | std::filesystem::perms::group_write;
+
+// (device, inode) of the socket at `path`, or nullopt if there is none.
+std::optional<std::pair<std::uint64_t, std::uint64_t>> SocketIdentity(const std::string& path) {
+#ifdef _WIN32
+  (void)path;
+  return std::nullopt;
+#else
+  struct stat info {};
+  if (::lstat(path.c_str(), &info) != 0 || !S_ISSOCK(info.st_mode)) {
+    return std::nullopt;
+  }
+  return std::pair<std::uint64_t, std::uint64_t>{info.st_dev, info.st_ino};
+#endif
+}
+
+// True for a Unix socket nobody is listening on, i.e. one left behind by a crashed server.
+bool IsStaleUnixSocket(const std::string& path) {
+#ifdef _WIN32
+  (void)path;
+  return false;
+#else
+  sockaddr_un addr{};
+  if (!SocketIdentity(path) || path.size() >= sizeof(addr.sun_path)) {
+    return false;
+  }
+  addr.sun_family = AF_UNIX;
+  std::memcpy(addr.sun_path, path.c_str(), path.size() + 1);
+  const int probe = ::socket(AF_UNIX, SOCK_STREAM, 0);
+  if (probe < 0) {
+    return false;
+  }
+  const bool refused =
+      ::connect(probe, reinterpret_cast<const sockaddr*>(&addr), sizeof(addr)) != 0 &&
+      errno == ECONNREFUSED;
+  ::close(probe);
+  return refused;
+#endif
+}
+
+std::optional<HttpMethod> ParseMethod(const std::string& method) {
+  if (method == "GET" || method == "HEAD") {
+    return HttpMethod::kGet;
+  }
+  if (method == "POST") {
+    return HttpMethod::kPost;
+  }
+  if (method == "PATCH") {
+    return HttpMethod::kPatch;
+  }
+  if (method == "OPTIONS") {
+    return HttpMethod::kOptions;
+  }
+  return std::nullopt;
+}
+
+}  // namespace
+
+class HttpServer::Impl {
+ public:
+  // Runs the route for `request` (path_params are filled in here). Body-carrying routes that are
+  // not streaming get the body from `read_body` in full first, and a body that cannot be read in
+  // full is answered 400 without running them. With `admit`, the request passes admission
+  // control as `request.client` before the body is read.
+  HttpResponse Handle(HttpMethod method, HttpRequest& request, const HttpBodyReader* read_body,
+                      bool admit = false) const {
+    RouteMatch match;
+    if (!router.Find(method, request.path, match)) {
+      if (method == HttpMethod::kOptions && preflight_handler && router.Routes(request.path)) {
+        return Guarded([&] { return preflight_handler(request); });
       }
-      for (const auto& header : response.headers) {
-        res.set_header(header.first.c_str(), header.second.c_str());
+      return NotFoundResponse();
+    }
+    AdmissionControl::Ticket ticket;
+    if (admit) {
+      if (auto rejection = admission.Admit(request.client, match.route->route_class, ticket)) {
+        return std::move(*rejection);
       }
-      res.status = response.status;
-      res.set_content(response.body, response.content_type);
-    } catch (const std::exception& ex) {
-      res.status = 500;
-      res.set_content(std::string{"{\"error\":\""} + ex.what() + "\"}", "application/json");
-    } catch (...) {
-      res.status = 500;
-      res.set_content("{\"error\":\"Unhandled server error\"}", "application/json");
     }
-  };
-}
+    request.path_params = std::move(match.path_params);
+    if (match.route->streaming_handler) {
+      // Dispatch callers hand over the whole body up front.
+      const HttpBodyReader buffered_body = [&request](const HttpBodyReceiver& receiver) {
+        return request.body.empty() || receiver(request.body.data(), request.body.size());
+      };
+      return Guarded([&] {
+        return match.route->streaming_handler(request, read_body ? *read_body : buffered_body);
+      });
+    }
+    if (read_body) {
+      const bool complete = (*read_body)([&request](const char* data, std::size_t length) {
+        request.body.append(data, length);
+        return true;
+      });
+      // A disconnect mid-upload or a malformed or oversized body; a handler must never act on a
+      // truncated body (an import would replace the checklist with the part that arrived).
+      if (!complete) {
+        return BadRequestResponse("{\"error\":\"Request body could not be read.\"}");
+      }
+    }
+    return Guarded([&] { return match.route->handler(request); });
+  }
 
-}  // namespace
+  // Requests are routed here rather than by httplib's per-route std::regex list. Bodiless methods
+  // are answered from the pre-routing hook; POST/PATCH go through one content-reader handler each
+  // so streaming routes can pull the body themselves. httplib only exposes the body stream to
+  // handlers it matches itself, so those two still cost one std::regex_match of `.*` against the
+  // path (~2 us, against a write transaction per request) before Router::Find runs.
+  void Install(httplib::Server& target, bool unix_socket) const {
+    // httplib closes a keep-alive connection after 5 requests by default, which would make pooled
+    // clients reconnect constantly; idle connections still close after the 5 s keep-alive timeout.
+    target.set_keep_alive_max_count(kKeepAliveMaxRequests);
+    // Headers and body go out as separate writes; on a reused connection Nagle would hold the
+    // body until the client's delayed ACK (~40 ms).
+    target.set_tcp_nodelay(true);
 
-HttpServer::HttpServer() : impl_(std::make_unique<Impl>()) {}
+    target.set_pre_routing_handler([this, unix_socket](const httplib::Request& req,
+                                                       httplib::Response& res) {
+      const auto method = ParseMethod(req.method);
+      if (!method || *method == HttpMethod::kPost || *method == HttpMethod::kPatch) {
+        return httplib::Server::HandlerResponse::Unhandled;
+      }
+      auto request = ConvertRequest(req, request_timeout, unix_socket);
+      WriteResponse(Handle(*method, request, nullptr, /*admit=*/true), res);
+      return httplib::Server::HandlerResponse::Handled;
+    });
+    const auto with_body = [this, unix_socket](HttpMethod method) {
+      return [this, method, unix_socket](const httplib::Request& req, httplib::Response& res,
+                                         const httplib::ContentReader& content_reader) {
+        bool body_failed = false;
+        const HttpBodyReader read_body = [&content_reader,
+                                          &body_failed](const HttpBodyReceiver& receiver) {
+          body_failed = !content_reader([&receiver](const char* data, std::size_t length) {
+            return receiver(data, length);
+          });
+          return !body_failed;
+        };
+        auto request = ConvertRequest(req, request_timeout, unix_socket);
+        auto response = Handle(method, request, &read_body, /*admit=*/true);
+        // httplib has already set 400 or 413 for a body it could not read; keep that status.
+        if (body_failed && res.status >= 400) {
+          response.status = res.status;
+        }
+        WriteResponse(response, res);
+      };
+    };
+    target.Post(".*", with_body(HttpMethod::kPost));
+    target.Patch(".*", with_body(HttpMethod::kPatch));
+  }
+
+  Router router;  // written only while handlers are registered
+  HttpHandler preflight_handler;
+  mutable AdmissionControl admission;
+  std::chrono::milliseconds request_timeout{0};
+  httplib::Server server;
+  std::string unix_socket_path;
+  std::unique_ptr<httplib::Server> unix_server;  // guarded by lifecycle_mutex
+  std::optional<std::pair<std::uint64_t, std::uint64_t>> unix_socket_identity;  // bound socket
+  std::mutex lifecycle_mutex;
+  bool running = false;
+};
+
+HttpServer::HttpServer() : impl_(std::make_unique<Impl>()) {
+  impl_->Install(impl_->server, /*unix_socket=*/false);
+}
 
 HttpServer::~HttpServer() = default;
 
-void HttpServer::AddHandler(HttpMethod method, const std::string& path, HttpHandler handler) {
+void HttpServer::AddHandler(HttpMethod method, const std::string& path, HttpHandler handler,
+                            std::optional<RouteClass> route_class) {
+  if (!handler) {
+    throw std::invalid_argument("HTTP handler must not be empty");
+  }
+  impl_->router.Add(method, path, std::move(handler), nullptr, route_class);
+}
+
+void HttpServer::AddStreamingHandler(HttpMethod method, const std::string& path,
+                                     HttpStreamingHandler handler,
+                                     std::optional<RouteClass> route_class) {
   if (!handler) {
     throw std::invalid_argument("HTTP handler must not be empty");
   }
+  if (method != HttpMethod::kPost && method != HttpMethod::kPatch) {
+    throw std::invalid_argument("Streaming handlers require a body-carrying HTTP method");
+  }
+  impl_->router.Add(method, path, nullptr, std::move(handler), route_class);
+}
+
+void HttpServer::SetPreflightHandler(HttpHandler handler) {
+  impl_->preflight_handler = std::move(handler);
+}
+
+void HttpServer::SetAdmissionPolicy(AdmissionPolicy policy) {
+  impl_->admission.SetPolicy(std::move(policy));
+}
+
+void HttpServer::SetRequestTimeout(std::chrono::milliseconds timeout) {
+  impl_->request_timeout = timeout;
+}
 
-  auto wrapped_handler = WrapHandler(std::move(handler));
+AdmissionStats HttpServer::Admission() const { return impl_->admission.Stats(); }
 
-  switch (method) {
-    case HttpMethod::kGet:
-      impl_->server.Get(path, std::move(wrapped_handler));
-      break;
-    case HttpMethod::kPost:
-      impl_->server.Post(path, std::move(wrapped_handler));
-      break;
-    case HttpMethod::kOptions:
-      impl_->server.Options(path, std::move(wrapped_handler));
-      break;
-    case HttpMethod::kPatch:
-      impl_->server.Patch(path, std::move(wrapped_handler));
-      break;
-    default:
-      throw std::invalid_argument("Unsupported HTTP method");
+void HttpServer::ListenOnUnixSocket(const std::string& path) {
+#ifdef _WIN32
+  (void)path;
+  throw std::invalid_argument("Unix domain sockets are not supported on this platform");
+#else
+  if (path.empty()) {
+    throw std::invalid_argument("Unix socket path must not be empty");
   }
+  impl_->unix_socket_path = path;
+#endif
+}
+
+HttpResponse HttpServer::Dispatch(HttpMethod method, HttpRequest request, bool admit) const {
+  // Socket requests reach handlers with the path already percent-decoded.
+  request.path = httplib::detail::decode_url(request.path, false);
+  return impl_->Handle(method, request, nullptr, admit);
 }
 
 void HttpServer::Start(const std::string& host, int port) {
@@ -100,11 +590,71 @@ void HttpServer::Start(const std::string& host, int port) {
     impl_->running = true;
   }
 
+  std::thread unix_listener;
+  if (!impl_->unix_socket_path.empty()) {
+    auto unix_server = std::make_unique<httplib::Server>();
+    impl_->Install(*unix_server, /*unix_socket=*/true);
+#ifndef _WIN32
+    unix_server->set_address_family(AF_UNIX);
+#endif
+    const auto fail = [this](const std::string& reason) {
+      std::lock_guard<std::mutex> lock(impl_->lifecycle_mutex);
+      impl_->running = false;
+      throw std::runtime_error("Failed to bind HTTP server to Unix socket " +
+                               impl_->unix_socket_path + ": " + reason);
+    };
+    // A socket left behind by a crashed run would make bind fail; anything else at the path (a
+    // regular file, or the socket of a live server) is not ours to remove.
+    std::error_code ignored;
+    const auto existing = std::filesystem::symlink_status(impl_->unix_socket_path, ignored);
+    if (std::filesystem::exists(existing)) {
+      if (!IsStaleUnixSocket(impl_->unix_socket_path)) {
+        fail("path exists and is not a stale socket");
+      }
+      std::filesystem::remove(impl_->unix_socket_path, ignored);
+    }
+    if (!unix_server->bind_to_port(impl_->unix_socket_path, 80)) {
+      fail("bind failed");
+    }
+    const auto owned_socket = SocketIdentity(impl_->unix_socket_path);
+    std::filesystem::permissions(impl_->unix_socket_path, kUnixSocketPermissions,
+                                 std::filesystem::perm_options::replace, ignored);
+    if (ignored) {
+      unix_server->stop();
+      std::filesystem::remove(impl_->unix_socket_path, ignored);
+      fail("cannot set permissions");
+    }
+    {
+      std::lock_guard<std::mutex> lock(impl_->lifecycle_mutex);
+      impl_->unix_server = std::move(unix_server);
+      impl_->unix_socket_identity = owned_socket;
+    }
+    unix_listener = std::thread([server = impl_->unix_server.get()] {
+      server->listen_after_bind();
+    });
+  }
+
   const bool ok = impl_->server.listen(host, port);
 
   {
     std::lock_guard<std::mutex> lock(impl_->lifecycle_mutex);
     impl_->running = false;
+    if (impl_->unix_server) {
+      impl_->unix_server->wait_until_ready();
+      impl_->unix_server->stop();
+    }
+  }
+  if (unix_listener.joinable()) {
+    unix_listener.join();
+    std::lock_guard<std::mutex> lock(impl_->lifecycle_mutex);
+    impl_->unix_server.reset();
+    // Only the socket this server bound; another instance may have replaced it since.
+    if (impl_->unix_socket_identity &&
+        SocketIdentity(impl_->unix_socket_path) == impl_->unix_socket_identity) {
+      std::error_code ignored;
+      std::filesystem::remove(impl_->unix_socket_path, ignored);
+    }
+    impl_->unix_socket_identity.reset();
   }
 
   if (!ok) {
@@ -113,6 +663,12 @@ void HttpServer::Start(const std::string& host, int port) {
   }
 }
 
-void HttpServer::Stop() { impl_->server.stop(); }
+void HttpServer::Stop() {
+  impl_->server.stop();
+  std::lock_guard<std::mutex> lock(impl_->lifecycle_mutex);
+  if (impl_->unix_server) {
+    impl_->unix_server->stop();
+  }
+}
 
 }  // namespace platform
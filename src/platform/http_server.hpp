@@ -1,8 +1,11 @@
 #pragma once
 
+#include <chrono>
+#include <cstdint>
 #include <functional>
 #include <map>
 #include <memory>
+#include <optional>
 #include <string>
 #include <vector>
 
@@ -16,6 +19,13 @@ struct HttpRequest {
   std::map<std::string, std::string> query_params;
   std::map<std::string, std::string> headers;
   std::vector<std::string> path_params;
+  // Admission key: the peer address of a TCP client. Empty for Unix-socket clients, which are
+  // exempt from per-client rate limits, and for requests built by hand.
+  std::string client;
+  // Set for requests arriving over a socket: when the work stops being wanted (see
+  // SetRequestTimeout), and a probe that reports whether the client has disconnected.
+  std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::time_point::max();
+  std::function<bool()> client_gone;
 };
 
 struct HttpResponse {
@@ -27,6 +37,43 @@ struct HttpResponse {
 
 using HttpHandler = std::function<HttpResponse(const HttpRequest&)>;
 
+// Receives one chunk of a request body; return false to stop reading.
+using HttpBodyReceiver = std::function<bool(const char* data, std::size_t length)>;
+// Pulls the body through the receiver; returns false if the client or receiver aborted.
+using HttpBodyReader = std::function<bool(const HttpBodyReceiver& receiver)>;
+// Handlers that consume the body incrementally instead of from `HttpRequest::body`.
+using HttpStreamingHandler =
+    std::function<HttpResponse(const HttpRequest&, const HttpBodyReader& read_body)>;
+
+// Admission classes for rate limiting. Unclassified routes are kRead for GET/OPTIONS and kWrite
+// for POST/PATCH. kUncharged routes pass admission without a token or a count; they are for
+// routes that only Dispatch their work to other routes with `admit`, so it is charged once there.
+enum class RouteClass { kRead = 0, kWrite, kHeavy, kUncharged };
+
+struct RateLimit {
+  double per_second = 0;  // per client; 0 admits everything
+  double burst = 1;       // bucket size, i.e. requests a quiet client may send at once
+};
+
+// Token buckets per (client address, route class), plus a server-wide cap on concurrent kHeavy
+// requests. Rejected requests get 429 with Retry-After and never reach the handler. Unix-socket
+// peers have no address to tell them apart; access to the socket is governed by its file
+// permissions, so they skip the buckets but still count against max_concurrent_heavy.
+struct AdmissionPolicy {
+  RateLimit read;
+  RateLimit write;
+  RateLimit heavy;
+  int max_concurrent_heavy = 0;  // 0 is unlimited
+  std::map<std::string, std::string> rejection_headers;  // added to every 429
+};
+
+struct AdmissionStats {
+  std::uint64_t admitted[3] = {};  // indexed by RouteClass (kUncharged is not counted)
+  std::uint64_t rate_limited[3] = {};
+  std::uint64_t concurrency_limited = 0;
+  int heavy_in_flight = 0;
+};
+
 class HttpServer {
  public:
   HttpServer();
@@ -35,7 +82,37 @@ class HttpServer {
   HttpServer(const HttpServer&) = delete;
   HttpServer& operator=(const HttpServer&) = delete;
 
-  void AddHandler(HttpMethod method, const std::string& path, HttpHandler handler);
+  // `path` is an exact path ("/api/health"), a prefix route whose non-empty remainder becomes
+  // the single path parameter ("/api/slug/(.+)"), a prefix route without parameters
+  // ("/api/slug/.*"), or else a regex. Exact routes win over prefixes (longest first), and
+  // prefixes over regexes; only the regex form costs a std::regex match in the router. POST and
+  // PATCH also pay one httplib `.*` match first (see Impl::Install).
+  void AddHandler(HttpMethod method, const std::string& path, HttpHandler handler,
+                  std::optional<RouteClass> route_class = std::nullopt);
+  // Body-carrying methods only (POST, PATCH); the body is never buffered in full.
+  void AddStreamingHandler(HttpMethod method, const std::string& path,
+                           HttpStreamingHandler handler,
+                           std::optional<RouteClass> route_class = std::nullopt);
+  // Runs the handler registered for `method` and `request.path` on the calling thread, as a
+  // request arriving over the socket would; `path_params` are filled from the route. Errors
+  // come back as a 500 response and unknown routes as 404. With `admit`, the route's class is
+  // admitted for `request.client` as a socket request would be (a 429 comes back as the
+  // response); callers nested in an admitted request pass it so their work counts too.
+  HttpResponse Dispatch(HttpMethod method, HttpRequest request, bool admit = false) const;
+  // Answers OPTIONS for any path another method routes, unless an OPTIONS route matches it.
+  void SetPreflightHandler(HttpHandler handler);
+  // Applies to requests arriving over the sockets; call before Start.
+  void SetAdmissionPolicy(AdmissionPolicy policy);
+  // Gives socket requests a deadline `timeout` after they arrive (zero: none). A client may ask
+  // for a shorter one with an X-Request-Timeout-Ms header. Call before Start.
+  void SetRequestTimeout(std::chrono::milliseconds timeout);
+  AdmissionStats Admission() const;
+  // Also serves every route on a Unix domain socket at `path` while Start runs. The socket is
+  // created with mode 0660, and its file permissions govern who may connect. A socket left by a
+  // crashed run (nothing accepts on it) is replaced. Start throws if anything else is at `path`,
+  // including a live server's socket. On shutdown the socket is removed only if it is still the
+  // one this server bound. Call before Start; POSIX only.
+  void ListenOnUnixSocket(const std::string& path);
   void Start(const std::string& host, int port);
   void Stop();
 
@@ -0,0 +1,421 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <ctime>
+#include <exception>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <regex>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "core/api_json.hpp"
+#include "core/checklist_markdown.hpp"
+#include "core/checklist_store.hpp"
+#include "core/corpus_generator.hpp"
+#include "core/logging.hpp"
+#include "nlohmann/json.hpp"
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+// Keeps the optimizer from discarding benchmark results (same trick as benchmark::DoNotOptimize).
+template <typename T>
+void DoNotOptimize(const T& value) {
+#if defined(__GNUC__) || defined(__clang__)
+  asm volatile("" : : "r,m"(value) : "memory");
+#else
+  static volatile const void* sink;
+  sink = &value;
+#endif
+}
+
+class State {
+ public:
+  State(std::uint64_t iterations, std::int64_t arg) : iterations_(iterations), arg_(arg) {}
+
+  std::int64_t range() const { return arg_; }
+  std::uint64_t iterations() const { return iterations_; }
+
+  // Excludes per-iteration setup from the measurement.
+  void PauseTiming() {
+    paused_at_ = Clock::now();
+    cpu_paused_at_ = std::clock();
+  }
+  void ResumeTiming() {
+    excluded_ += Clock::now() - paused_at_;
+    cpu_excluded_ += std::clock() - cpu_paused_at_;
+  }
+  Clock::duration excluded() const { return excluded_; }
+  std::clock_t cpu_excluded() const { return cpu_excluded_; }
+
+ private:
+  std::uint64_t iterations_;
+  std::int64_t arg_;
+  Clock::time_point paused_at_{};
+  Clock::duration excluded_{};
+  std::clock_t cpu_paused_at_ = 0;
+  std::clock_t cpu_excluded_ = 0;
+};
+
+using BenchmarkFn = std::function<void(State&)>;
+
+struct Benchmark {
+  std::string name;
+  BenchmarkFn fn;
+  std::vector<std::int64_t> args;
+};
+
+struct Result {
+  std::string name;
+  std::uint64_t iterations = 0;
+  double real_time_ns = 0.0;
+  double cpu_time_ns = 0.0;
+};
+
+std::vector<Benchmark>& Registry() {
+  static std::vector<Benchmark> benchmarks;
+  return benchmarks;
+}
+
+void Register(std::string name, BenchmarkFn fn, std::vector<std::int64_t> args = {}) {
+  Registry().push_back({std::move(name), std::move(fn), std::move(args)});
+}
+
+// Grows the iteration count until a run lasts at least `min_time`, as Google Benchmark does.
+Result RunBenchmark(const std::string& name, const BenchmarkFn& fn, std::int64_t arg,
+                    double min_time_seconds) {
+  std::uint64_t iterations = 1;
+  while (true) {
+    State state(iterations, arg);
+    const std::clock_t cpu_start = std::clock();
+    const auto start = Clock::now();
+    fn(state);
+    const auto elapsed = Clock::now() - start - state.excluded();
+    const std::clock_t cpu_elapsed = std::clock() - cpu_start - state.cpu_excluded();
+
+    const double seconds = std::chrono::duration<double>(elapsed).count();
+    if (seconds >= min_time_seconds || iterations >= 1'000'000'000ULL) {
+      Result result;
+      result.name = name;
+      result.iterations = iterations;
+      result.real_time_ns = seconds * 1e9 / static_cast<double>(iterations);
+      result.cpu_time_ns = static_cast<double>(cpu_elapsed) / CLOCKS_PER_SEC * 1e9 /
+                           static_cast<double>(iterations);
+      return result;
+    }
+    const double scale = seconds > 0.0 ? (min_time_seconds * 1.4) / seconds : 10.0;
+    const auto next = static_cast<std::uint64_t>(static_cast<double>(iterations) *
+                                                 std::clamp(scale, 2.0, 10.0));
+    iterations = std::max<std::uint64_t>(next, iterations + 1);
+  }
+}
+
+// --- Fixtures ---------------------------------------------------------------------------------
+
+// Synthetic checklist of roughly `count` slugs laid out as sections of up to 20 procedures.
+std::vector<core::ChecklistSlug> MakeSlugs(const std::string& checklist, std::int64_t count) {
+  core::corpus::CorpusSpec spec;
+  spec.checklists = 1;
+  spec.procedures = static_cast<int>(std::min<std::int64_t>(count, 20));
+  spec.sections = static_cast<int>(std::max<std::int64_t>(1, count / spec.procedures));
+  spec.checklist_prefix = checklist;
+  return core::corpus::GenerateChecklist(spec, 0);
+}
+
+struct StoreFixture {
+  std::unique_ptr<core::ChecklistStore> store;
+  std::vector<std::string> address_ids;
+};
+
+StoreFixture MakeStore(std::int64_t slug_count) {
+  StoreFixture fixture;
+  fixture.store = std::make_unique<core::ChecklistStore>(":memory:");
+  fixture.store->Initialize(/*seed_demo_data=*/false);
+  const auto slugs = MakeSlugs("bench", slug_count);
+  fixture.store->ReplaceChecklist(slugs.front().checklist, slugs);
+  for (const auto& slug : slugs) {
+    fixture.address_ids.push_back(slug.address_id);
+  }
+  return fixture;
+}
+
+// --- Benchmarks -------------------------------------------------------------------------------
+
+void RegisterBenchmarks() {
+  Register("BM_ComputeAddressId", [](State& state) {
+    const std::string section = "Networking";
+    const std::string procedure = "Switch bring-up";
+    const std::string action = "Verify uplink";
+    const std::string spec = "1GbE link up";
+    for (std::uint64_t i = 0; i < state.iterations(); ++i) {
+      DoNotOptimize(core::ComputeAddressId("apim-demo", section, procedure, action, spec));
+    }
+  });
+
+  Register("BM_ParseStatus", [](State& state) {
+    const std::vector<std::string> inputs = {"Pass", "fail", "N/A", "Other", "bogus"};
+    for (std::uint64_t i = 0; i < state.iterations(); ++i) {
+      DoNotOptimize(core::ParseStatus(inputs[i % inputs.size()]));
+    }
+  });
+
+  Register("BM_StatusToString", [](State& state) {
+    const core::ChecklistStatus statuses[] = {core::ChecklistStatus::kPass,
+                                              core::ChecklistStatus::kFail,
+                                              core::ChecklistStatus::kNA,
+                                              core::ChecklistStatus::kOther};
+    for (std::uint64_t i = 0; i < state.iterations(); ++i) {
+      DoNotOptimize(core::StatusToString(statuses[i % 4]));
+    }
+  });
+
+  Register(
+      "BM_ParseChecklistMarkdown",
+      [](State& state) {
+        state.PauseTiming();
+        const auto slugs = MakeSlugs("bench", state.range());
+        const auto& name = slugs.front().checklist;
+        const auto markdown = core::markdown::ExportChecklistMarkdown(name, slugs);
+        state.ResumeTiming();
+        for (std::uint64_t i = 0; i < state.iterations(); ++i) {
+          DoNotOptimize(core::markdown::ParseChecklistMarkdown(name, markdown));
+        }
+      },
+      {10, 100, 1000});
+
+  Register(
+      "BM_ExportChecklistMarkdown",
+      [](State& state) {
+        state.PauseTiming();
+        const auto slugs = MakeSlugs("bench", state.range());
+        state.ResumeTiming();
+        for (std::uint64_t i = 0; i < state.iterations(); ++i) {
+          DoNotOptimize(core::markdown::ExportChecklistMarkdown("bench", slugs));
+        }
+      },
+      {10, 100, 1000});
+
+  Register("BM_SlugToJson", [](State& state) {
+    const auto slug = MakeSlugs("bench", 2).back();
+    for (std::uint64_t i = 0; i < state.iterations(); ++i) {
+      DoNotOptimize(core::SlugToJson(slug).dump());
+    }
+  });
+
+  Register("BM_ParseUpdatePayload", [](State& state) {
+    const std::string body =
+        R"({"address_id":"0123456789ABCDEF","status":"Pass","result":"24.1V",)"
+        R"("comment":"Measured at supply taps.","timestamp":"2026-01-01T00:00:00Z"})";
+    for (std::uint64_t i = 0; i < state.iterations(); ++i) {
+      DoNotOptimize(core::ParseUpdatePayload(nlohmann::json::parse(body)));
+    }
+  });
+
+  Register(
+      "BM_Store_GetSlugOrThrow",
+      [](State& state) {
+        state.PauseTiming();
+        auto fixture = MakeStore(state.range());
+        state.ResumeTiming();
+        const auto& ids = fixture.address_ids;
+        for (std::uint64_t i = 0; i < state.iterations(); ++i) {
+          DoNotOptimize(fixture.store->GetSlugOrThrow(ids[i % ids.size()]));
+        }
+      },
+      {100, 10000});
+
+  Register(
+      "BM_Store_ApplyUpdate",
+      [](State& state) {
+        state.PauseTiming();
+        auto fixture = MakeStore(state.range());
+        state.ResumeTiming();
+        const auto& ids = fixture.address_ids;
+        core::SlugUpdate update;
+        update.status = core::ChecklistStatus::kFail;
+        for (std::uint64_t i = 0; i < state.iterations(); ++i) {
+          update.address_id = ids[i % ids.size()];
+          update.comment = "iteration " + std::to_string(i);
+          fixture.store->ApplyUpdate(update);
+        }
+      },
+      {100, 10000});
+}
+
+// --- Reporting --------------------------------------------------------------------------------
+
+struct Options {
+  std::string filter = ".*";
+  double min_time_seconds = 0.5;
+  std::string format = "console";
+  std::string out_path;
+  std::string out_format = "json";
+};
+
+void PrintUsage() {
+  std::cout << "Usage: apim-bench [options]\n"
+               "  --benchmark_filter=<regex>        Only run benchmarks whose name matches\n"
+               "  --benchmark_min_time=<seconds>    Minimum measured time per benchmark (0.5)\n"
+               "  --benchmark_format=console|json   Stdout format (console)\n"
+               "  --benchmark_out=<file>            Also write results to <file>\n"
+               "  --benchmark_out_format=json|console  Format for --benchmark_out (json)\n"
+               "  --benchmark_list_tests            List benchmark names and exit\n";
+}
+
+std::string LocalTimestamp() {
+  const std::time_t now = std::time(nullptr);
+  std::tm tm_snapshot{};
+#if defined(_WIN32)
+  localtime_s(&tm_snapshot, &now);
+#else
+  localtime_r(&now, &tm_snapshot);
+#endif
+  char buffer[32];
+  std::strftime(buffer, sizeof(buffer), "%Y-%m-%dT%H:%M:%S%z", &tm_snapshot);
+  return buffer;
+}
+
+// Mirrors the Google Benchmark JSON reporter so existing compare tooling can diff builds.
+nlohmann::json ResultsToJson(const std::vector<Result>& results, const std::string& executable) {
+  nlohmann::json benchmarks = nlohmann::json::array();
+  for (const auto& result : results) {
+    benchmarks.push_back({{"name", result.name},
+                          {"run_name", result.name},
+                          {"run_type", "iteration"},
+                          {"repetitions", 1},
+                          {"threads", 1},
+                          {"iterations", result.iterations},
+                          {"real_time", result.real_time_ns},
+                          {"cpu_time", result.cpu_time_ns},
+                          {"time_unit", "ns"}});
+  }
+#if defined(NDEBUG)
+  const char* build_type = "release";
+#else
+  const char* build_type = "debug";
+#endif
+  return {{"context",
+           {{"date", LocalTimestamp()},
+            {"executable", executable},
+            {"num_cpus", std::thread::hardware_concurrency()},
+            {"library_build_type", build_type}}},
+          {"benchmarks", benchmarks}};
+}
+
+std::string ResultsToConsole(const std::vector<Result>& results) {
+  std::ostringstream out;
+  out << std::left << std::setw(40) << "Benchmark" << std::right << std::setw(16) << "Time"
+      << std::setw(16) << "CPU" << std::setw(14) << "Iterations" << "\n";
+  out << std::string(86, '-') << "\n";
+  out << std::fixed << std::setprecision(1);
+  for (const auto& result : results) {
+    out << std::left << std::setw(40) << result.name << std::right << std::setw(13)
+        << result.real_time_ns << " ns" << std::setw(13) << result.cpu_time_ns << " ns"
+        << std::setw(14) << result.iterations << "\n";
+  }
+  return out.str();
+}
+
+Options ParseOptions(int argc, char** argv, bool& list_only) {
+  Options options;
+  for (int i = 1; i < argc; ++i) {
+    const std::string arg = argv[i];
+    if (arg == "--help" || arg == "-h") {
+      PrintUsage();
+      std::exit(0);
+    }
+    if (arg == "--benchmark_list_tests") {
+      list_only = true;
+      continue;
+    }
+    const auto eq = arg.find('=');
+    if (eq == std::string::npos) {
+      throw std::invalid_argument("Unrecognized argument: " + arg);
+    }
+    const auto key = arg.substr(0, eq);
+    const auto value = arg.substr(eq + 1);
+    if (key == "--benchmark_filter") {
+      options.filter = value;
+    } else if (key == "--benchmark_min_time") {
+      options.min_time_seconds = std::stod(value);
+    } else if (key == "--benchmark_format") {
+      options.format = value;
+    } else if (key == "--benchmark_out") {
+      options.out_path = value;
+    } else if (key == "--benchmark_out_format") {
+      options.out_format = value;
+    } else {
+      throw std::invalid_argument("Unrecognized option: " + key);
+    }
+  }
+  return options;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  core::logging::SetLogLevel(core::logging::LogLevel::kError);
+  try {
+    bool list_only = false;
+    const auto options = ParseOptions(argc, argv, list_only);
+    const std::regex filter(options.filter);
+    RegisterBenchmarks();
+
+    std::vector<std::pair<std::string, std::pair<const Benchmark*, std::int64_t>>> selected;
+    for (const auto& benchmark : Registry()) {
+      if (benchmark.args.empty()) {
+        selected.push_back({benchmark.name, {&benchmark, 0}});
+        continue;
+      }
+      for (const auto arg : benchmark.args) {
+        selected.push_back({benchmark.name + "/" + std::to_string(arg), {&benchmark, arg}});
+      }
+    }
+    selected.erase(std::remove_if(selected.begin(), selected.end(),
+                                  [&](const auto& item) {
+                                    return !std::regex_search(item.first, filter);
+                                  }),
+                   selected.end());
+
+    if (list_only) {
+      for (const auto& item : selected) {
+        std::cout << item.first << "\n";
+      }
+      return 0;
+    }
+
+    std::vector<Result> results;
+    for (const auto& [name, target] : selected) {
+      results.push_back(
+          RunBenchmark(name, target.first->fn, target.second, options.min_time_seconds));
+    }
+
+    const auto as_json = ResultsToJson(results, argv[0]);
+    if (options.format == "json") {
+      std::cout << as_json.dump(2) << std::endl;
+    } else {
+      std::cout << ResultsToConsole(results);
+    }
+    if (!options.out_path.empty()) {
+      std::ofstream out(options.out_path);
+      if (!out) {
+        throw std::runtime_error("Cannot open --benchmark_out file: " + options.out_path);
+      }
+      out << (options.out_format == "console" ? ResultsToConsole(results)
+                                               : as_json.dump(2) + "\n");
+    }
+  } catch (const std::exception& ex) {
+    std::cerr << "apim-bench failure: " << ex.what() << std::endl;
+    return 1;
+  }
+  return 0;
+}
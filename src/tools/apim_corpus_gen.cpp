@@ -0,0 +1,137 @@
+#include <cstdlib>
+#include <exception>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+
+#include "core/checklist_store.hpp"
+#include "core/corpus_generator.hpp"
+#include "core/logging.hpp"
+
+namespace {
+
+struct Options {
+  core::corpus::CorpusSpec spec;
+  std::string markdown_dir;
+  std::string db_path;
+};
+
+void PrintUsage() {
+  std::cout
+      << "Usage: apim-corpus-gen [options] (--markdown-dir=<dir> and/or --db=<path>)\n"
+         "  --checklists=<n>             Checklists to generate (default 10)\n"
+         "  --sections=<n>               Sections per checklist (default 10)\n"
+         "  --procedures=<n>             Procedures per section (default 20)\n"
+         "  --relationship-density=<x>   Mean outgoing relationships per slug (default 0.5)\n"
+         "  --instruction-words=<n>      Words of instruction text per slug (default 40)\n"
+         "  --history-depth=<n>          Updates replayed per slug after import (default 0)\n"
+         "  --seed=<n>                   Generator seed (default 1)\n"
+         "  --prefix=<name>              Checklist name prefix (default 'synthetic')\n"
+         "  --markdown-dir=<dir>         Write one <checklist>.md per checklist\n"
+         "  --db=<path>                  Populate a SQLite runtime store via ReplaceChecklist\n";
+}
+
+int ParseInt(const std::string& key, const std::string& value, int minimum) {
+  int parsed = 0;
+  try {
+    parsed = std::stoi(value);
+  } catch (const std::exception&) {
+    throw std::invalid_argument("Invalid value for --" + key + ": " + value);
+  }
+  if (parsed < minimum) {
+    throw std::invalid_argument("--" + key + " must be >= " + std::to_string(minimum));
+  }
+  return parsed;
+}
+
+Options ParseOptions(int argc, char** argv) {
+  Options options;
+  auto& spec = options.spec;
+  for (int i = 1; i < argc; ++i) {
+    const std::string arg = argv[i];
+    if (arg == "--help" || arg == "-h") {
+      PrintUsage();
+      std::exit(0);
+    }
+    const auto eq = arg.find('=');
+    if (arg.rfind("--", 0) != 0 || eq == std::string::npos) {
+      throw std::invalid_argument("Unrecognized argument: " + arg);
+    }
+    const auto key = arg.substr(2, eq - 2);
+    const auto value = arg.substr(eq + 1);
+    if (key == "checklists") {
+      spec.checklists = ParseInt(key, value, 1);
+    } else if (key == "sections") {
+      spec.sections = ParseInt(key, value, 1);
+    } else if (key == "procedures") {
+      spec.procedures = ParseInt(key, value, 1);
+    } else if (key == "relationship-density") {
+      spec.relationship_density = std::stod(value);
+    } else if (key == "instruction-words") {
+      spec.instruction_words = ParseInt(key, value, 0);
+    } else if (key == "history-depth") {
+      spec.history_depth = ParseInt(key, value, 0);
+    } else if (key == "seed") {
+      spec.seed = std::stoull(value);
+    } else if (key == "prefix") {
+      spec.checklist_prefix = value;
+    } else if (key == "markdown-dir") {
+      options.markdown_dir = value;
+    } else if (key == "db") {
+      options.db_path = value;
+    } else {
+      throw std::invalid_argument("Unrecognized option: --" + key);
+    }
+  }
+  if (options.markdown_dir.empty() && options.db_path.empty()) {
+    throw std::invalid_argument("Specify --markdown-dir and/or --db.");
+  }
+  return options;
+}
+
+void WriteMarkdown(const Options& options) {
+  namespace fs = std::filesystem;
+  fs::create_directories(options.markdown_dir);
+  for (int c = 0; c < options.spec.checklists; ++c) {
+    const auto name = core::corpus::ChecklistName(options.spec, c);
+    const auto path = fs::path(options.markdown_dir) / (name + ".md");
+    std::ofstream out(path, std::ios::binary);
+    if (!out) {
+      throw std::runtime_error("Cannot write " + path.string());
+    }
+    out << core::corpus::GenerateChecklistMarkdown(options.spec, c);
+  }
+  std::cout << "Wrote " << options.spec.checklists << " Markdown checklists to "
+            << options.markdown_dir << "\n";
+}
+
+void PopulateDatabase(const Options& options) {
+  core::ChecklistStore store(options.db_path);
+  store.Initialize(/*seed_demo_data=*/false);
+  const auto stats = core::corpus::PopulateStore(store, options.spec);
+  std::cout << "Populated " << options.db_path << ": " << stats.checklists << " checklists, "
+            << stats.slugs << " slugs, " << stats.relationships << " relationships, "
+            << stats.history_rows << " history rows\n";
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  core::logging::SetLogLevel(core::logging::LogLevel::kWarn);
+  core::logging::InitializeFromEnvironment();
+  try {
+    const auto options = ParseOptions(argc, argv);
+    if (!options.markdown_dir.empty()) {
+      WriteMarkdown(options);
+    }
+    if (!options.db_path.empty()) {
+      PopulateDatabase(options);
+    }
+  } catch (const std::exception& ex) {
+    std::cerr << "apim-corpus-gen: " << ex.what() << "\n";
+    return 1;
+  }
+  return 0;
+}
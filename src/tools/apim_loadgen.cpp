@@ -0,0 +1,482 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <exception>
+#include <filesystem>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "core/app.hpp"
+#include "core/checklist_store.hpp"
+#include "core/corpus_generator.hpp"
+#include "core/logging.hpp"
+#include "nlohmann/json.hpp"
+#include "platform/http_client.hpp"
+#include "platform/http_server.hpp"
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+struct Options {
+  std::string base_url;
+  std::string host = "127.0.0.1";
+  int port = 18090;
+  std::string db_path;
+  std::string storage_profile = "balanced";
+  int wal_checkpoint_ms = 1000;
+  core::corpus::CorpusSpec corpus = {/*checklists=*/10, /*sections=*/5, /*procedures=*/20,
+                                     /*relationship_density=*/0.5, /*instruction_words=*/40,
+                                     /*history_depth=*/0, /*seed=*/42, "load"};
+  int connections = 16;
+  int duration_seconds = 10;
+  int warmup_seconds = 1;
+  int bulk_size = 20;
+  std::uint64_t seed = 42;
+  std::map<std::string, int> mix = {
+      {"get_slug", 60}, {"get_checklist", 15}, {"update", 18}, {"update_bulk", 5}, {"export", 2}};
+  bool json_output = false;
+};
+
+const std::vector<std::string> kOperations = {"get_slug", "get_checklist", "update",
+                                              "update_bulk", "export"};
+
+void PrintUsage() {
+  std::cout
+      << "Usage: apim-loadgen [options]\n"
+         "  --base-url=<url>       Target an already running server instead of spinning one up\n"
+         "  --port=<n>             Port for the in-process server (default 18090)\n"
+         "  --db=<path>            SQLite path for the in-process server (default: temp file)\n"
+         "  --storage-profile=<p>  durable, balanced, or throughput for the in-process store\n"
+         "  --wal-checkpoint-ms=<n>  Background WAL checkpoint interval; 0 leaves checkpoints\n"
+         "                         to SQLite's inline autocheckpoint (default 1000)\n"
+         "  --checklists=<n>       Synthetic checklists to seed (default 10)\n"
+         "  --sections=<n>         Sections per checklist (default 5)\n"
+         "  --procedures=<n>       Procedures per section (default 20)\n"
+         "  --relationship-density=<x>  Mean relationships per synthetic slug (default 0.5)\n"
+         "  --instruction-words=<n>     Instruction length per synthetic slug (default 40)\n"
+         "  --history-depth=<n>    History rows pre-seeded per slug (default 0)\n"
+         "  --connections=<n>      Concurrent client connections (default 16)\n"
+         "  --duration=<s>         Measured run time in seconds (default 10)\n"
+         "  --warmup=<s>           Unmeasured warm-up time in seconds (default 1)\n"
+         "  --bulk-size=<n>        Updates per /api/update_bulk call (default 20)\n"
+         "  --mix=<op:w,...>       Workload weights for get_slug, get_checklist, update,\n"
+         "                         update_bulk, export (default 60,15,18,5,2)\n"
+         "  --seed=<n>             Seed for the synthetic corpus and request streams (default 42)\n"
+         "  --json                 Emit the report as JSON\n";
+}
+
+int ParseInt(const std::string& key, const std::string& value, int minimum) {
+  int parsed = 0;
+  try {
+    parsed = std::stoi(value);
+  } catch (const std::exception&) {
+    throw std::invalid_argument("Invalid value for --" + key + ": " + value);
+  }
+  if (parsed < minimum) {
+    throw std::invalid_argument("--" + key + " must be >= " + std::to_string(minimum));
+  }
+  return parsed;
+}
+
+std::map<std::string, int> ParseMix(const std::string& value) {
+  std::map<std::string, int> mix;
+  for (const auto& op : kOperations) {
+    mix[op] = 0;
+  }
+  std::istringstream stream(value);
+  std::string item;
+  while (std::getline(stream, item, ',')) {
+    const auto colon = item.find(':');
+    if (colon == std::string::npos) {
+      throw std::invalid_argument("Mix entries must be 'operation:weight': " + item);
+    }
+    const auto op = item.substr(0, colon);
+    if (std::find(kOperations.begin(), kOperations.end(), op) == kOperations.end()) {
+      throw std::invalid_argument("Unknown operation in --mix: " + op);
+    }
+    mix[op] = ParseInt("mix", item.substr(colon + 1), 0);
+  }
+  return mix;
+}
+
+Options ParseOptions(int argc, char** argv) {
+  Options options;
+  for (int i = 1; i < argc; ++i) {
+    const std::string arg = argv[i];
+    if (arg == "--help" || arg == "-h") {
+      PrintUsage();
+      std::exit(0);
+    }
+    if (arg == "--json") {
+      options.json_output = true;
+      continue;
+    }
+    const auto eq = arg.find('=');
+    if (arg.rfind("--", 0) != 0 || eq == std::string::npos) {
+      throw std::invalid_argument("Unrecognized argument: " + arg);
+    }
+    const auto key = arg.substr(2, eq - 2);
+    const auto value = arg.substr(eq + 1);
+    if (key == "base-url") {
+      options.base_url = value;
+    } else if (key == "port") {
+      options.port = ParseInt(key, value, 1);
+    } else if (key == "db") {
+      options.db_path = value;
+    } else if (key == "storage-profile") {
+      core::StorageProfile(value);  // validates the name up front
+      options.storage_profile = value;
+    } else if (key == "wal-checkpoint-ms") {
+      options.wal_checkpoint_ms = ParseInt(key, value, 0);
+    } else if (key == "checklists") {
+      options.corpus.checklists = ParseInt(key, value, 1);
+    } else if (key == "sections") {
+      options.corpus.sections = ParseInt(key, value, 1);
+    } else if (key == "procedures") {
+      options.corpus.procedures = ParseInt(key, value, 1);
+    } else if (key == "relationship-density") {
+      options.corpus.relationship_density = std::stod(value);
+    } else if (key == "instruction-words") {
+      options.corpus.instruction_words = ParseInt(key, value, 0);
+    } else if (key == "history-depth") {
+      options.corpus.history_depth = ParseInt(key, value, 0);
+    } else if (key == "connections") {
+      options.connections = ParseInt(key, value, 1);
+    } else if (key == "duration") {
+      options.duration_seconds = ParseInt(key, value, 1);
+    } else if (key == "warmup") {
+      options.warmup_seconds = ParseInt(key, value, 0);
+    } else if (key == "bulk-size") {
+      options.bulk_size = ParseInt(key, value, 1);
+    } else if (key == "mix") {
+      options.mix = ParseMix(value);
+    } else if (key == "seed") {
+      options.seed = static_cast<std::uint64_t>(ParseInt(key, value, 0));
+      options.corpus.seed = options.seed;
+    } else {
+      throw std::invalid_argument("Unrecognized option: --" + key);
+    }
+  }
+  return options;
+}
+
+struct Corpus {
+  std::vector<std::string> checklists;
+  std::vector<std::string> address_ids;
+};
+
+Corpus SeedSyntheticStore(core::ChecklistStore& store, const Options& options) {
+  Corpus corpus;
+  core::corpus::PopulateStore(
+      store, options.corpus,
+      [&corpus](const std::string& checklist, const std::vector<core::ChecklistSlug>& slugs) {
+        corpus.checklists.push_back(checklist);
+        for (const auto& slug : slugs) {
+          corpus.address_ids.push_back(slug.address_id);
+        }
+      });
+  return corpus;
+}
+
+Corpus DiscoverCorpus(const platform::HttpClient& client) {
+  const auto response = client.Get("/api/export/json");
+  if (response.status != 200) {
+    throw std::runtime_error("Failed to discover corpus: HTTP " + std::to_string(response.status));
+  }
+  const auto payload = nlohmann::json::parse(response.body, nullptr, false);
+  if (!payload.is_array()) {
+    throw std::runtime_error("Export response is not a JSON array");
+  }
+  Corpus corpus;
+  for (const auto& slug : payload) {
+    corpus.address_ids.push_back(slug.value("address_id", ""));
+    const auto checklist = slug.value("checklist", "");
+    if (corpus.checklists.empty() || corpus.checklists.back() != checklist) {
+      corpus.checklists.push_back(checklist);
+    }
+  }
+  if (corpus.address_ids.empty()) {
+    throw std::runtime_error("Target server has no slugs to exercise");
+  }
+  return corpus;
+}
+
+void WaitForServer(const platform::HttpClient& client) {
+  const auto deadline = Clock::now() + std::chrono::seconds(10);
+  while (Clock::now() < deadline) {
+    try {
+      if (client.Get("/api/health").status == 200) {
+        return;
+      }
+    } catch (const std::exception&) {
+      // not listening yet
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  }
+  throw std::runtime_error("Server did not become ready within 10s");
+}
+
+struct OperationSamples {
+  std::vector<double> latencies_ms;
+  std::uint64_t errors = 0;
+};
+
+using ThreadSamples = std::map<std::string, OperationSamples>;
+
+const char* kStatuses[] = {"Pass", "Fail", "NA", "Other"};
+
+int ExecuteOperation(const platform::HttpClient& client, const std::string& op,
+                     const Corpus& corpus, int bulk_size, std::mt19937_64& rng) {
+  std::uniform_int_distribution<std::size_t> pick_slug(0, corpus.address_ids.size() - 1);
+  std::uniform_int_distribution<std::size_t> pick_status(0, 3);
+
+  if (op == "get_slug") {
+    return client.Get("/api/slug/" + corpus.address_ids[pick_slug(rng)]).status;
+  }
+  if (op == "get_checklist") {
+    std::uniform_int_distribution<std::size_t> pick(0, corpus.checklists.size() - 1);
+    return client.Get("/api/checklist/" + corpus.checklists[pick(rng)]).status;
+  }
+  if (op == "update") {
+    const nlohmann::json payload = {{"address_id", corpus.address_ids[pick_slug(rng)]},
+                                    {"status", kStatuses[pick_status(rng)]},
+                                    {"comment", "loadgen"}};
+    return client.Patch("/api/update", payload.dump()).status;
+  }
+  if (op == "update_bulk") {
+    nlohmann::json payload = nlohmann::json::array();
+    for (int i = 0; i < bulk_size; ++i) {
+      payload.push_back({{"address_id", corpus.address_ids[pick_slug(rng)]},
+                         {"status", kStatuses[pick_status(rng)]}});
+    }
+    return client.Patch("/api/update_bulk", payload.dump()).status;
+  }
+  return client.Get("/api/export/json").status;
+}
+
+void RunWorker(const std::string& base_url, const Options& options, const Corpus& corpus,
+               std::size_t worker_index, Clock::time_point measure_start,
+               Clock::time_point stop_at, ThreadSamples& samples) {
+  platform::HttpClient client(base_url);
+  std::mt19937_64 rng(options.seed + worker_index);
+
+  std::vector<std::string> ops;
+  std::vector<int> weights;
+  for (const auto& op : kOperations) {
+    const auto it = options.mix.find(op);
+    ops.push_back(op);
+    weights.push_back(it == options.mix.end() ? 0 : it->second);
+  }
+  std::discrete_distribution<std::size_t> pick_op(weights.begin(), weights.end());
+
+  while (true) {
+    const auto started = Clock::now();
+    if (started >= stop_at) {
+      break;
+    }
+    const auto& op = ops[pick_op(rng)];
+    bool ok = false;
+    try {
+      const int status = ExecuteOperation(client, op, corpus, options.bulk_size, rng);
+      ok = status >= 200 && status < 300;
+    } catch (const std::exception&) {
+      ok = false;
+    }
+    const auto finished = Clock::now();
+    if (started < measure_start) {
+      continue;
+    }
+    auto& bucket = samples[op];
+    bucket.latencies_ms.push_back(
+        std::chrono::duration<double, std::milli>(finished - started).count());
+    if (!ok) {
+      ++bucket.errors;
+    }
+  }
+}
+
+double Percentile(const std::vector<double>& sorted, double fraction) {
+  if (sorted.empty()) {
+    return 0.0;
+  }
+  const auto rank = static_cast<std::size_t>(fraction * static_cast<double>(sorted.size() - 1));
+  return sorted[rank];
+}
+
+nlohmann::json BuildReport(const Options& options, const Corpus& corpus,
+                           const std::vector<ThreadSamples>& per_thread) {
+  std::map<std::string, OperationSamples> merged;
+  for (const auto& samples : per_thread) {
+    for (const auto& [op, bucket] : samples) {
+      auto& target = merged[op];
+      target.latencies_ms.insert(target.latencies_ms.end(), bucket.latencies_ms.begin(),
+                                 bucket.latencies_ms.end());
+      target.errors += bucket.errors;
+    }
+  }
+
+  const double seconds = static_cast<double>(options.duration_seconds);
+  nlohmann::json endpoints = nlohmann::json::array();
+  std::uint64_t total_requests = 0;
+  std::uint64_t total_errors = 0;
+  for (auto& [op, bucket] : merged) {
+    std::sort(bucket.latencies_ms.begin(), bucket.latencies_ms.end());
+    const auto count = bucket.latencies_ms.size();
+    total_requests += count;
+    total_errors += bucket.errors;
+    endpoints.push_back({{"operation", op},
+                         {"requests", count},
+                         {"errors", bucket.errors},
+                         {"throughput_rps", static_cast<double>(count) / seconds},
+                         {"p50_ms", Percentile(bucket.latencies_ms, 0.50)},
+                         {"p99_ms", Percentile(bucket.latencies_ms, 0.99)},
+                         {"p999_ms", Percentile(bucket.latencies_ms, 0.999)},
+                         {"max_ms", count ? bucket.latencies_ms.back() : 0.0}});
+  }
+
+  return {{"config",
+           {{"connections", options.connections},
+            {"duration_s", options.duration_seconds},
+            {"bulk_size", options.bulk_size},
+            {"seed", options.seed},
+            {"mix", options.mix},
+            {"relationship_density", options.corpus.relationship_density},
+            {"history_depth", options.corpus.history_depth},
+            {"checklists", corpus.checklists.size()},
+            {"slugs", corpus.address_ids.size()}}},
+          {"total",
+           {{"requests", total_requests},
+            {"errors", total_errors},
+            {"throughput_rps", static_cast<double>(total_requests) / seconds}}},
+          {"endpoints", endpoints}};
+}
+
+void PrintReport(const nlohmann::json& report) {
+  const auto& config = report.at("config");
+  std::cout << "apim-loadgen: " << config.at("slugs") << " slugs in " << config.at("checklists")
+            << " checklists, " << config.at("connections") << " connections, "
+            << config.at("duration_s") << "s\n\n";
+  std::cout << std::left << std::setw(14) << "operation" << std::right << std::setw(10)
+            << "requests" << std::setw(8) << "errors" << std::setw(11) << "rps" << std::setw(10)
+            << "p50 ms" << std::setw(10) << "p99 ms" << std::setw(10) << "p999 ms"
+            << std::setw(10) << "max ms" << "\n";
+  std::cout << std::fixed << std::setprecision(2);
+  for (const auto& row : report.at("endpoints")) {
+    std::cout << std::left << std::setw(14) << row.at("operation").get<std::string>()
+              << std::right << std::setw(10) << row.at("requests").get<std::uint64_t>()
+              << std::setw(8) << row.at("errors").get<std::uint64_t>() << std::setw(11)
+              << row.at("throughput_rps").get<double>() << std::setw(10)
+              << row.at("p50_ms").get<double>() << std::setw(10)
+              << row.at("p99_ms").get<double>() << std::setw(10)
+              << row.at("p999_ms").get<double>() << std::setw(10)
+              << row.at("max_ms").get<double>() << "\n";
+  }
+  const auto& total = report.at("total");
+  std::cout << "\ntotal: " << total.at("requests").get<std::uint64_t>() << " requests, "
+            << total.at("errors").get<std::uint64_t>() << " errors, "
+            << total.at("throughput_rps").get<double>() << " req/s\n";
+}
+
+int Run(const Options& options) {
+  std::string base_url = options.base_url;
+  std::unique_ptr<core::ChecklistStore> store;
+  std::unique_ptr<platform::HttpServer> server;
+  std::thread server_thread;
+  std::string db_path = options.db_path;
+  Corpus corpus;
+
+  if (base_url.empty()) {
+    if (db_path.empty()) {
+      db_path = (std::filesystem::temp_directory_path() / "apim-loadgen.db").string();
+      std::error_code ec;
+      std::filesystem::remove(db_path, ec);
+      std::filesystem::remove(db_path + "-wal", ec);
+      std::filesystem::remove(db_path + "-shm", ec);
+    }
+    store = std::make_unique<core::ChecklistStore>(db_path,
+                                                   core::StorageProfile(options.storage_profile));
+    store->Initialize(/*seed_demo_data=*/false);
+    if (options.wal_checkpoint_ms > 0) {
+      core::WalCheckpointPolicy policy;
+      policy.interval = std::chrono::milliseconds(options.wal_checkpoint_ms);
+      store->StartWalCheckpointer(policy);
+    }
+    corpus = SeedSyntheticStore(*store, options);
+
+    server = std::make_unique<platform::HttpServer>();
+    core::ConfigureServer(*server, *store);
+    server_thread = std::thread([&] {
+      try {
+        server->Start(options.host, options.port);
+      } catch (const std::exception& ex) {
+        std::cerr << "apim-loadgen: server error: " << ex.what() << std::endl;
+      }
+    });
+    base_url = "http://" + options.host + ":" + std::to_string(options.port);
+  }
+
+  int exit_code = 0;
+  try {
+    platform::HttpClient probe(base_url);
+    WaitForServer(probe);
+    if (corpus.address_ids.empty()) {
+      corpus = DiscoverCorpus(probe);
+    }
+
+    const auto measure_start = Clock::now() + std::chrono::seconds(options.warmup_seconds);
+    const auto stop_at = measure_start + std::chrono::seconds(options.duration_seconds);
+    std::vector<ThreadSamples> samples(static_cast<std::size_t>(options.connections));
+    std::vector<std::thread> workers;
+    for (std::size_t i = 0; i < samples.size(); ++i) {
+      workers.emplace_back(RunWorker, std::cref(base_url), std::cref(options), std::cref(corpus),
+                           i, measure_start, stop_at, std::ref(samples[i]));
+    }
+    for (auto& worker : workers) {
+      worker.join();
+    }
+
+    const auto report = BuildReport(options, corpus, samples);
+    if (options.json_output) {
+      std::cout << report.dump(2) << std::endl;
+    } else {
+      PrintReport(report);
+    }
+    if (report.at("total").at("errors").get<std::uint64_t>() > 0) {
+      exit_code = 2;
+    }
+  } catch (const std::exception& ex) {
+    std::cerr << "apim-loadgen failure: " << ex.what() << std::endl;
+    exit_code = 1;
+  }
+
+  if (server) {
+    server->Stop();
+    if (server_thread.joinable()) {
+      server_thread.join();
+    }
+  }
+  return exit_code;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  core::logging::SetLogLevel(core::logging::LogLevel::kWarn);
+  core::logging::InitializeFromEnvironment();
+  try {
+    return Run(ParseOptions(argc, argv));
+  } catch (const std::exception& ex) {
+    std::cerr << "apim-loadgen: " << ex.what() << "\n";
+    PrintUsage();
+    return 1;
+  }
+}
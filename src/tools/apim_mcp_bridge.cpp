@@ -1,9 +1,15 @@
 #include <algorithm>
 #include <cctype>
+#include <condition_variable>
 #include <cstdlib>
+#include <deque>
+#include <functional>
 #include <iostream>
+#include <mutex>
 #include <optional>
 #include <string>
+#include <thread>
+#include <vector>
 
 #include "core/mcp_bridge.hpp"
 #include "nlohmann/json.hpp"
@@ -67,18 +73,116 @@ std::optional<nlohmann::json> ReadMessage() {
   return parsed;
 }
 
+std::mutex stdout_mutex;
+
+// Workers finish tools/call requests in any order, so every frame is written whole under a lock.
 void WriteMessage(const nlohmann::json& payload) {
   const std::string serialized = payload.dump();
+  std::lock_guard<std::mutex> lock(stdout_mutex);
   std::cout << "Content-Length: " << serialized.size() << "\r\n\r\n" << serialized;
   std::cout.flush();
 }
 
-nlohmann::json MakeResultPayload(const nlohmann::json& id, const nlohmann::json& result) {
-  return {{"jsonrpc", "2.0"}, {"id", id}, {"result", result}};
+using core::mcp::MakeErrorPayload;
+using core::mcp::MakeResultPayload;
+
+// Fixed set of threads running tools/call requests so that a host fanning out several calls
+// gets them executed concurrently; responses carry the request id and go out as they finish.
+class ToolCallPool {
+ public:
+  explicit ToolCallPool(std::size_t workers) {
+    for (std::size_t i = 0; i < workers; ++i) {
+      threads_.emplace_back([this] { Run(); });
+    }
+  }
+
+  ~ToolCallPool() {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      stopping_ = true;
+    }
+    ready_.notify_all();
+    for (auto& thread : threads_) {
+      thread.join();
+    }
+  }
+
+  void Submit(std::function<void()> task) {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      tasks_.push_back(std::move(task));
+    }
+    ready_.notify_one();
+  }
+
+  // Blocks until every submitted call has written its response.
+  void Drain() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    idle_.wait(lock, [this] { return tasks_.empty() && active_ == 0; });
+  }
+
+ private:
+  void Run() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (true) {
+      ready_.wait(lock, [this] { return stopping_ || !tasks_.empty(); });
+      if (tasks_.empty()) {
+        return;
+      }
+      auto task = std::move(tasks_.front());
+      tasks_.pop_front();
+      ++active_;
+      lock.unlock();
+      task();
+      lock.lock();
+      --active_;
+      if (tasks_.empty() && active_ == 0) {
+        idle_.notify_all();
+      }
+    }
+  }
+
+  std::mutex mutex_;
+  std::condition_variable ready_;
+  std::condition_variable idle_;
+  std::deque<std::function<void()>> tasks_;
+  std::size_t active_ = 0;
+  bool stopping_ = false;
+  std::vector<std::thread> threads_;
+};
+
+std::size_t ReadWorkerCount() {
+  const std::string value = GetEnv("APIM_MCP_WORKERS", "8");
+  try {
+    const int workers = std::stoi(value);
+    if (workers >= 1 && workers <= 64) {
+      return static_cast<std::size_t>(workers);
+    }
+  } catch (const std::exception&) {
+  }
+  std::cerr << "APIM_MCP_WORKERS must be between 1 and 64; using 8" << std::endl;
+  return 8;
 }
 
-nlohmann::json MakeErrorPayload(const nlohmann::json& id, int code, const std::string& message) {
-  return {{"jsonrpc", "2.0"}, {"id", id}, {"error", {{"code", code}, {"message", message}}}};
+core::mcp::DisplayOptions ReadDisplayOptions() {
+  core::mcp::DisplayOptions options;
+  const std::string output = GetEnv("APIM_MCP_OUTPUT", "pretty");
+  if (output != "pretty" && output != "compact") {
+    std::cerr << "APIM_MCP_OUTPUT must be 'pretty' or 'compact'; using pretty" << std::endl;
+  }
+  options.compact = output == "compact";
+  const std::string budget = GetEnv("APIM_MCP_MAX_RESULT_BYTES", "0");
+  try {
+    const long long bytes = std::stoll(budget);
+    if (bytes < 0) {
+      throw std::out_of_range(budget);
+    }
+    options.max_bytes = static_cast<std::size_t>(bytes);
+  } catch (const std::exception&) {
+    std::cerr << "APIM_MCP_MAX_RESULT_BYTES must be a non-negative byte count; no budget applied"
+              << std::endl;
+  }
+  return options;
 }
 
 }  // namespace
@@ -89,7 +193,11 @@ int main() {
         GetEnv("APIM_MCP_BASE_URL", "http://" + GetEnv("APIM_CPP_HOST", "127.0.0.1") + ":" +
                                          GetEnv("APIM_CPP_PORT", "8080"));
 
-    core::mcp::Bridge bridge(base_url);
+    const std::size_t workers = ReadWorkerCount();
+    // One pooled keep-alive connection per worker.
+    core::mcp::Bridge bridge(base_url, workers);
+    const core::mcp::DisplayOptions display = ReadDisplayOptions();
+    ToolCallPool pool(workers);
     bool initialized = false;
 
     while (true) {
@@ -113,6 +221,7 @@ int main() {
       }
 
       if (method == "shutdown") {
+        pool.Drain();
         initialized = false;
         WriteMessage(MakeResultPayload(id, nlohmann::json::object()));
         continue;
@@ -124,19 +233,14 @@ int main() {
       }
 
       if (method == "tools/call") {
-        try {
-          const auto& params = message->at("params");
-          const std::string tool_name = params.at("name").get<std::string>();
-          const auto arguments =
-              params.contains("arguments") ? params.at("arguments") : nlohmann::json::object();
-          const auto response = bridge.CallTool(tool_name, arguments);
-          nlohmann::json content = {
-              {"content", nlohmann::json::array({{{"type", "text"},
-                                                  {"text", core::mcp::FormatResponseForDisplay(response)}}})}};
-          WriteMessage(MakeResultPayload(id, content));
-        } catch (const std::exception& ex) {
-          WriteMessage(MakeErrorPayload(id, -32000, ex.what()));
-        }
+        pool.Submit([&bridge, &display, id, request = std::move(*message)] {
+          try {
+            WriteMessage(
+                MakeResultPayload(id, bridge.CallToolContent(request.at("params"), display)));
+          } catch (const std::exception& ex) {
+            WriteMessage(MakeErrorPayload(id, -32000, ex.what()));
+          }
+        });
         continue;
       }
 
@@ -154,6 +258,7 @@ int main() {
       }
     }
 
+    pool.Drain();
     if (initialized) {
       WriteMessage(MakeErrorPayload(nullptr, -32000, "MCP host terminated without shutdown."));
     }
@@ -1,7 +1,18 @@
+#include <algorithm>
+#include <chrono>
 #include <filesystem>
+#include <fstream>
 #include <iostream>
+#include <iterator>
+#include <optional>
+#include <string>
+#include <utility>
+#include <thread>
+#include <vector>
 
 #include "core/checklist_store.hpp"
+#include "core/snapshot.hpp"
+#include "sqlite3.h"
 
 namespace {
 
@@ -24,6 +35,13 @@ int main() {
   try {
     core::ChecklistStore store(db_path);
     store.Initialize(/*seed_demo_data=*/false);
+    // The default profile keeps SQLite's durable settings, as read back after Initialize.
+    const auto storage = store.EffectiveStorageSettings();
+    if (storage.profile != "durable" || storage.synchronous != "FULL" ||
+        storage.mmap_size_bytes != 0 || storage.wal_autocheckpoint_pages != 1000) {
+      std::cerr << "Default storage settings are not durable\n";
+      return 1;
+    }
 
     core::ChecklistSlug slug;
     slug.checklist = "integration-checklist";
@@ -59,6 +77,313 @@ int main() {
       return 1;
     }
 
+    // A bulk update is all-or-nothing, and the read model serving GetSlugOrThrow follows it.
+    const core::SlugUpdate good{slug.address_id, std::string{"done"}, core::ChecklistStatus::kPass,
+                                std::nullopt, std::nullopt};
+    const core::SlugUpdate missing{"MISSING", std::nullopt, core::ChecklistStatus::kFail,
+                                   std::nullopt, std::nullopt};
+    bool bulk_threw = false;
+    try {
+      store.ApplyBulkUpdates({good, missing});
+    } catch (const std::exception&) {
+      bulk_threw = true;
+    }
+    if (!bulk_threw || store.GetSlugOrThrow(slug.address_id).result != slug.result) {
+      std::cerr << "Failed bulk update was not rolled back\n";
+      return 1;
+    }
+    // A cancelled operation throws before doing work and leaves nothing behind.
+    core::Cancellation expired;
+    expired.deadline = std::chrono::steady_clock::now();
+    bool deadline_hit = false;
+    try {
+      store.ApplyBulkUpdates({good}, expired);
+    } catch (const core::OperationCancelled& ex) {
+      deadline_hit = ex.deadline_exceeded();
+    }
+    core::Cancellation abandoned;
+    abandoned.abandoned = [] { return true; };
+    bool abandon_hit = false;
+    try {
+      store.QuerySlugs({}, abandoned);
+    } catch (const core::OperationCancelled& ex) {
+      abandon_hit = !ex.deadline_exceeded();
+    }
+    if (!deadline_hit || !abandon_hit ||
+        store.GetSlugOrThrow(slug.address_id).result != slug.result) {
+      std::cerr << "Cancelled store operations did not stop cleanly\n";
+      return 1;
+    }
+    store.ApplyBulkUpdates({good});
+    const auto updated = store.GetSlugsForChecklist(slug.checklist);
+    if (updated.size() != 1 || updated.front().result != "done" ||
+        updated.front().status != core::ChecklistStatus::kPass ||
+        updated.front().section != slug.section) {
+      std::cerr << "Read model did not reflect the bulk update\n";
+      return 1;
+    }
+    // The checklist is now cached; a committed update must be patched into the cached row.
+    store.ApplyUpdate({slug.address_id, std::nullopt, std::nullopt, std::string{"cached"},
+                       std::nullopt});
+    const auto cache_stats = store.CachedSlugStats();
+    if (cache_stats.slugs != 1 || store.GetSlugsForChecklist(slug.checklist).front().comment !=
+                                      "cached" ||
+        store.CachedSlugStats().hits <= cache_stats.hits) {
+      std::cerr << "Slug cache did not serve the updated checklist\n";
+      return 1;
+    }
+
+    // History range queries are newest-first with an exclusive upper bound; retention keeps
+    // only the newest rows per slug.
+    for (const char* ts : {"2020-01-01T01:00:00Z", "2020-01-01T02:00:00Z",
+                           "2020-01-01T03:00:00Z"}) {
+      store.ApplyUpdate({slug.address_id, std::string{ts}, std::nullopt, std::nullopt,
+                         std::string{ts}});
+    }
+    const auto ranged = store.GetHistory(
+        slug.address_id, {"2020-01-01T01:00:00Z", "2020-01-01T03:00:00Z", /*limit=*/10});
+    const auto limited = store.GetHistory(slug.address_id, {"", "", /*limit=*/1});
+    if (ranged.size() != 2 || ranged.front().timestamp != "2020-01-01T02:00:00Z" ||
+        limited.size() != 1 || limited.front().timestamp <= "2020-01-01T03:00:00Z") {
+      std::cerr << "History range query returned unexpected rows\n";
+      return 1;
+    }
+    core::HistoryRetention retention;
+    retention.max_per_address = 2;
+    const auto pruned = store.PruneHistory(retention, "", /*max_addresses=*/10);
+    if (pruned.addresses != 1 || !pruned.next_address.empty() ||
+        store.GetHistory(slug.address_id, {}).size() != 2) {
+      std::cerr << "History retention did not keep the newest rows\n";
+      return 1;
+    }
+    // Downsampling keeps the newest row per bucket and age removes old rows; timestamps SQLite
+    // cannot parse are left to neither rule.
+    for (const char* ts : {"2021-01-01T00:10:00Z", "2021-01-01T00:20:00Z", "2021-01-01T01:10:00Z",
+                           "yesterday", "n/a"}) {
+      store.ApplyUpdate({slug.address_id, std::string{ts}, std::nullopt, std::nullopt,
+                         std::string{ts}});
+    }
+    const auto history_timestamps = [&store, &slug] {
+      std::vector<std::string> timestamps;
+      for (const auto& entry : store.GetHistory(slug.address_id, {})) {
+        timestamps.push_back(entry.timestamp);
+      }
+      std::sort(timestamps.begin(), timestamps.end());
+      return timestamps;
+    };
+    const auto before_downsample = history_timestamps();
+    core::HistoryRetention downsample;
+    downsample.downsample_after = std::chrono::hours(24);
+    downsample.downsample_bucket = std::chrono::hours(1);
+    const auto downsampled = store.PruneHistory(downsample, "", /*max_addresses=*/10);
+    const auto after_downsample = history_timestamps();
+    const auto kept = [](const std::vector<std::string>& timestamps, const std::string& ts) {
+      return std::find(timestamps.begin(), timestamps.end(), ts) != timestamps.end();
+    };
+    if (downsampled.rows_deleted != 1 || after_downsample.size() != before_downsample.size() - 1 ||
+        kept(after_downsample, "2021-01-01T00:10:00Z") ||
+        !kept(after_downsample, "2021-01-01T00:20:00Z") ||
+        !kept(after_downsample, "2021-01-01T01:10:00Z") || !kept(after_downsample, "yesterday") ||
+        !kept(after_downsample, "n/a")) {
+      std::cerr << "History downsampling did not keep the newest row per bucket\n";
+      return 1;
+    }
+    core::HistoryRetention aged;
+    aged.max_age = std::chrono::hours(24);
+    const auto aged_out = store.PruneHistory(aged, "", /*max_addresses=*/10);
+    const auto after_age = history_timestamps();
+    const auto old_rows = std::count_if(after_age.begin(), after_age.end(), [](const auto& ts) {
+      return ts.rfind("2020-", 0) == 0 || ts.rfind("2021-", 0) == 0;
+    });
+    if (aged_out.rows_deleted != 3 || after_age.size() != after_downsample.size() - 3 ||
+        old_rows != 0 || !kept(after_age, "yesterday") || !kept(after_age, "n/a")) {
+      std::cerr << "History age retention removed unexpected rows\n";
+      return 1;
+    }
+
+    const auto snapshot_path = db_path + ".snapshot";
+    RemoveIfExists(snapshot_path);
+    const auto snapshot = store.Snapshot(snapshot_path, {/*pages_per_step=*/1,
+                                                         std::chrono::milliseconds(0)});
+    core::ChecklistStore restored(snapshot_path);
+    restored.Initialize(/*seed_demo_data=*/false);
+    if (snapshot.pages <= 0 || restored.GetSlugOrThrow(slug.address_id).action != slug.action) {
+      std::cerr << "Snapshot did not capture the inserted slug\n";
+      return 1;
+    }
+
+    // Warm-up pulls the file through the page cache and preloads the slug cache within budget.
+    const auto warm = restored.WarmUp(std::chrono::seconds(10));
+    if (!warm.complete || warm.bytes_read <= 0 || warm.rows_visited <= 0 ||
+        restored.CachedSlugStats().slugs == 0 ||
+        restored.WarmUp(std::chrono::milliseconds(0)).complete) {
+      std::cerr << "Warm-up did not load the restored store\n";
+      return 1;
+    }
+
+    // A failed restore leaves the target and its WAL in place; a successful one applies once.
+    const auto restore_target = db_path + ".target";
+    const auto bad_snapshot = db_path + ".bad";
+    const auto blocked_target = db_path + ".blocked";
+    auto write_file = [](const std::string& path, const std::string& text) {
+      std::ofstream(path, std::ios::binary | std::ios::trunc) << text;
+    };
+    auto read_file = [](const std::string& path) {
+      std::ifstream in(path, std::ios::binary);
+      return std::string{std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>()};
+    };
+    write_file(bad_snapshot, "not a database");
+    write_file(restore_target, "old image");
+    write_file(restore_target + "-wal", "old frames");
+    std::filesystem::create_directories(blocked_target + "/occupied");
+    write_file(blocked_target + "-wal", "old frames");
+    int restore_failures = 0;
+    for (const auto& [from, to] : {std::pair{bad_snapshot, restore_target},
+                                   std::pair{snapshot_path, blocked_target}}) {
+      try {
+        core::RestoreSnapshot(from, to);
+      } catch (const std::exception&) {
+        ++restore_failures;
+      }
+    }
+    if (restore_failures != 2 || read_file(restore_target) != "old image" ||
+        read_file(restore_target + "-wal") != "old frames" ||
+        read_file(blocked_target + "-wal") != "old frames" ||
+        std::filesystem::exists(blocked_target + "-wal.pre-restore")) {
+      std::cerr << "Failed restore disturbed the target database\n";
+      return 1;
+    }
+    if (!core::RestoreSnapshotOnce(snapshot_path, restore_target) ||
+        std::filesystem::exists(restore_target + "-wal") ||
+        std::filesystem::exists(restore_target + "-wal.pre-restore")) {
+      std::cerr << "Restore did not replace the target database\n";
+      return 1;
+    }
+    {
+      core::ChecklistStore target(restore_target);
+      target.Initialize(/*seed_demo_data=*/false);
+      target.ApplyUpdate({slug.address_id, std::string{"after restore"}, std::nullopt,
+                          std::nullopt, std::nullopt});
+    }
+    const auto repeated = core::RestoreSnapshotOnce(snapshot_path, restore_target);
+    core::ChecklistStore target(restore_target);
+    target.Initialize(/*seed_demo_data=*/false);
+    if (repeated || target.GetSlugOrThrow(slug.address_id).result != "after restore") {
+      std::cerr << "Restarting with the same snapshot discarded later writes\n";
+      return 1;
+    }
+
+    core::WalCheckpointPolicy policy;
+    policy.interval = std::chrono::milliseconds(5);
+    policy.truncate_after_idle = std::chrono::milliseconds(20);
+    store.StartWalCheckpointer(policy);
+    for (int i = 0; i < 10; ++i) {
+      store.ApplyUpdate({slug.address_id, "run " + std::to_string(i), std::nullopt, std::nullopt,
+                         std::nullopt});
+    }
+    auto checkpoints = store.WalCheckpointerStats();
+    for (int i = 0; i < 200 && checkpoints && checkpoints->truncate_runs == 0; ++i) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(5));
+      checkpoints = store.WalCheckpointerStats();
+    }
+    if (!checkpoints || checkpoints->commits_observed < 10 || checkpoints->passive_runs == 0 ||
+        checkpoints->truncate_runs == 0 || checkpoints->wal_bytes != 0 ||
+        store.EffectiveStorageSettings().wal_autocheckpoint_pages != 0) {
+      std::cerr << "Background checkpointer did not take over WAL checkpoints\n";
+      return 1;
+    }
+
+    // Filtered, projected listings page through the read model by keyset.
+    std::vector<core::ChecklistSlug> paged;
+    for (const auto status : {core::ChecklistStatus::kPass, core::ChecklistStatus::kFail,
+                              core::ChecklistStatus::kPass}) {
+      core::ChecklistSlug row = slug;
+      row.checklist = "paged-checklist";
+      row.action = "Step " + std::to_string(paged.size());
+      row.status = status;
+      row.address_id = core::ComputeAddressId(row.checklist, row.section, row.procedure,
+                                              row.action, row.spec);
+      paged.push_back(row);
+    }
+    store.ReplaceChecklist("paged-checklist", paged);
+    core::SlugQuery query;
+    query.checklist = "paged-checklist";
+    query.statuses = {core::ChecklistStatus::kPass};
+    query.limit = 1;
+    query.fields = core::kSlugFieldStatus;
+    const auto first_page = store.QuerySlugs(query);
+    query.after = first_page.next_cursor;
+    const auto second_page = store.QuerySlugs(query);
+    if (first_page.slugs.size() != 1 ||
+        first_page.slugs.front().address_id != paged[0].address_id ||
+        !first_page.slugs.front().action.empty() || second_page.slugs.size() != 1 ||
+        second_page.slugs.front().address_id != paged[2].address_id ||
+        !second_page.next_cursor.empty()) {
+      std::cerr << "Keyset pagination returned unexpected pages\n";
+      return 1;
+    }
+    // The cursor holds the sort key, so it still resumes after its slug is deleted.
+    store.ReplaceChecklist("paged-checklist", {paged[1], paged[2]});
+    const auto after_delete = store.QuerySlugs(query);
+    store.ReplaceChecklist("paged-checklist", paged);
+    if (after_delete.slugs.size() != 1 ||
+        after_delete.slugs.front().address_id != paged[2].address_id) {
+      std::cerr << "Keyset cursor did not survive deleting its slug\n";
+      return 1;
+    }
+
+    // The search index follows address_id, not `slugs` rowids, which VACUUM may renumber.
+    std::vector<core::ChecklistSlug> searchable;
+    for (const char* action : {"Calibrate gauge", "Inspect gasket"}) {
+      core::ChecklistSlug row = slug;
+      row.checklist = "search-checklist";
+      row.action = action;
+      row.address_id = core::ComputeAddressId(row.checklist, row.section, row.procedure,
+                                              row.action, row.spec);
+      searchable.push_back(row);
+    }
+    store.ReplaceChecklist("search-checklist", searchable);
+    sqlite3* raw = nullptr;
+    const bool renumbered =
+        sqlite3_open(db_path.c_str(), &raw) == SQLITE_OK &&
+        sqlite3_exec(raw, "PRAGMA busy_timeout=5000; UPDATE slugs SET rowid = rowid + 1000;",
+                     nullptr, nullptr, nullptr) == SQLITE_OK;
+    sqlite3_close(raw);
+    searchable[0].instructions = "Use the zeppelin wrench";
+    store.ReplaceChecklist("search-checklist", {searchable[0]});
+    const auto search_hits = [&store](const std::string& text) {
+      return store.Search({text, {"search-checklist"}, /*limit=*/10}).size();
+    };
+    if (!renumbered || search_hits("calibrate") != 1 || search_hits("zeppelin") != 1 ||
+        search_hits("gasket") != 0) {
+      std::cerr << "Search index drifted after slugs rowids changed\n";
+      return 1;
+    }
+
+    // Roll-up counters follow status changes and checklist replacement without a rescan.
+    auto section_rollup = store.GetStatusRollup(core::RollupLevel::kSection, "paged-checklist");
+    store.ApplyUpdate({paged[0].address_id, std::nullopt, core::ChecklistStatus::kFail,
+                       std::nullopt, std::nullopt});
+    const auto after_update = store.GetStatusRollup(core::RollupLevel::kProcedure,
+                                                    "paged-checklist");
+    store.ReplaceChecklist("paged-checklist", {});
+    if (section_rollup.size() != 1 || section_rollup.front().section != slug.section ||
+        section_rollup.front().Count(core::ChecklistStatus::kPass) != 2 ||
+        section_rollup.front().Count(core::ChecklistStatus::kFail) != 1 ||
+        after_update.size() != 1 || after_update.front().Total() != 3 ||
+        after_update.front().Count(core::ChecklistStatus::kFail) != 2 ||
+        !store.GetStatusRollup(core::RollupLevel::kChecklist, "paged-checklist").empty()) {
+      std::cerr << "Status roll-up did not track updates\n";
+      return 1;
+    }
+
+    for (const auto& path : {snapshot_path, bad_snapshot, restore_target,
+                             restore_target + "-wal", restore_target + "-shm",
+                             restore_target + ".restored-from", blocked_target + "-wal"}) {
+      RemoveIfExists(path);
+    }
+    std::filesystem::remove_all(blocked_target);
+    RemoveIfExists(snapshot_path);
     RemoveIfExists(db_path);
     return 0;
   } catch (const std::exception& ex) {
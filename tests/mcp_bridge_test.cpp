@@ -1,18 +1,37 @@
+#include <algorithm>
+#include <atomic>
 #include <chrono>
+#include <cstddef>
+#include <cstdio>
 #include <exception>
 #include <filesystem>
+#include <fstream>
+#include <functional>
+#include <future>
 #include <iostream>
 #include <mutex>
 #include <string>
 #include <thread>
+#include <utility>
 #include <vector>
 
 #include "core/app.hpp"
 #include "core/checklist_store.hpp"
 #include "core/mcp_bridge.hpp"
+#include "core/single_flight.hpp"
+#include "core/slug_cursor.hpp"
 #include "nlohmann/json.hpp"
+#include "platform/http_client.hpp"
 #include "platform/http_server.hpp"
 
+#ifndef _WIN32
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
 namespace {
 
 void Assert(bool condition, const std::string& message) {
@@ -21,6 +40,52 @@ void Assert(bool condition, const std::string& message) {
   }
 }
 
+// Binds a Unix socket at `path` and closes it without unlinking, as a crashed server would.
+void LeaveStaleSocket(const std::string& path) {
+#ifndef _WIN32
+  sockaddr_un addr{};
+  addr.sun_family = AF_UNIX;
+  std::snprintf(addr.sun_path, sizeof(addr.sun_path), "%s", path.c_str());
+  const int fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+  Assert(fd >= 0 && ::bind(fd, reinterpret_cast<const sockaddr*>(&addr), sizeof(addr)) == 0,
+         "Could not create a stale Unix socket");
+  ::close(fd);
+#else
+  (void)path;
+#endif
+}
+
+// Sends `raw` to a local TCP port and returns the status line of the reply. With `end_upload`
+// the client half-closes after sending, which httplib treats as a disconnect (no reply).
+std::string SendRawRequest(int port, const std::string& raw, bool end_upload) {
+#ifndef _WIN32
+  sockaddr_in addr{};
+  addr.sin_family = AF_INET;
+  addr.sin_port = htons(static_cast<std::uint16_t>(port));
+  addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+  const int fd = ::socket(AF_INET, SOCK_STREAM, 0);
+  Assert(fd >= 0 && ::connect(fd, reinterpret_cast<const sockaddr*>(&addr), sizeof(addr)) == 0,
+         "Could not connect for a raw request");
+  Assert(::send(fd, raw.data(), raw.size(), 0) == static_cast<ssize_t>(raw.size()),
+         "Could not send a raw request");
+  if (end_upload) {
+    ::shutdown(fd, SHUT_WR);
+  }
+  std::string reply;
+  char buffer[512];
+  for (ssize_t n; (n = ::recv(fd, buffer, sizeof(buffer), 0)) > 0;) {
+    reply.append(buffer, static_cast<std::size_t>(n));
+  }
+  ::close(fd);
+  return reply.substr(0, reply.find("\r\n"));
+#else
+  (void)port;
+  (void)raw;
+  (void)end_upload;
+  return {};
+#endif
+}
+
 class TestServer {
  public:
   explicit TestServer(std::string db_path) : db_path_(std::move(db_path)), store_(db_path_) {
@@ -36,9 +101,12 @@ class TestServer {
     }
   }
 
-  void Start(const std::string& host, int port) {
+  void Start(const std::string& host, int port, const std::string& unix_socket = {}) {
     host_ = host;
     port_ = port;
+    if (!unix_socket.empty()) {
+      server_.ListenOnUnixSocket(unix_socket);
+    }
     worker_ = std::thread([this] {
       try {
         server_.Start(host_, port_);
@@ -80,13 +148,19 @@ void RunTests() {
   const auto db_path =
       (std::filesystem::temp_directory_path() / "apim-mcp-bridge-test.db").string();
   TestServer server(db_path);
-  server.Start("127.0.0.1", kTestPort);
+#ifdef _WIN32
+  const std::string unix_socket;
+#else
+  const auto unix_socket =
+      (std::filesystem::temp_directory_path() / "apim-mcp-bridge-test.sock").string();
+#endif
+  server.Start("127.0.0.1", kTestPort, unix_socket);
 
   core::mcp::Bridge bridge("http://127.0.0.1:" + std::to_string(kTestPort));
 
   const auto tools = bridge.ToolSchemasJson();
   Assert(tools.is_array(), "Tool schema response must be an array");
-  Assert(tools.size() == 12, "Unexpected number of MCP tools exposed");
+  Assert(tools.size() == 15, "Unexpected number of MCP tools exposed");
 
   const auto hello_response =
       bridge.CallTool("apim.hello", nlohmann::json::object({{"name", "Agent"}}));
@@ -126,6 +200,21 @@ void RunTests() {
   Assert(update_json.value("comment", "") == updated_comment,
          "apim.update_slug did not persist comment");
 
+  const auto update_many_response = bridge.CallTool(
+      "apim.update_slugs",
+      {{"updates", {{{"address_id", address_id}, {"result", "batched"}}}}});
+  Assert(update_many_response.status == 200, "apim.update_slugs status must be 200");
+  const auto get_many_response = bridge.CallTool(
+      "apim.get_slugs", {{"address_ids", {address_id, "MISSING"}}, {"fields", "result,comment"}});
+  Assert(get_many_response.status == 200, "apim.get_slugs status must be 200");
+  const auto get_many_json = nlohmann::json::parse(get_many_response.body, nullptr, false);
+  Assert(get_many_json["slugs"].size() == 1 &&
+             get_many_json["slugs"][0].value("result", "") == "batched" &&
+             get_many_json["slugs"][0].value("comment", "") == updated_comment &&
+             !get_many_json["slugs"][0].contains("action") &&
+             get_many_json["missing"] == nlohmann::json::array({"MISSING"}),
+         "apim.get_slugs should return projected slugs and list unknown IDs");
+
   const auto relationships_response = bridge.CallTool(
       "apim.relationships", nlohmann::json::object({{"address_id", address_id}}));
   Assert(relationships_response.status == 200, "apim.relationships status must be 200");
@@ -141,7 +230,412 @@ void RunTests() {
                               {"markdown", export_md_response.body}}));
   Assert(import_md_response.status == 200, "apim.import_markdown status must be 200");
 
+  // The search index is rebuilt by the Markdown import above, so this also covers replacement.
+  const auto search_response = bridge.CallTool(
+      "apim.search", nlohmann::json::object({{"query", export_json.at(0).value("action", "")},
+                                             {"checklist", checklist_name},
+                                             {"limit", 5}}));
+  Assert(search_response.status == 200, "apim.search status must be 200");
+  const auto search_json = nlohmann::json::parse(search_response.body, nullptr, false);
+  Assert(search_json.contains("results") && !search_json["results"].empty() &&
+             search_json["results"].at(0).value("address_id", "") == address_id,
+         "apim.search should rank the slug whose action was searched first");
+
+  platform::HttpClient http("http://127.0.0.1:" + std::to_string(kTestPort));
+  const auto jsonl = http.Get("/api/export/jsonl");
+  Assert(jsonl.status == 200, "export/jsonl status must be 200");
+  Assert(http.Get("/api/export/json?status=unknown,pass").status == 200,
+         "status filter names should be case-insensitive, Unknown included");
+  Assert(http.Get("/api/export/json?status=unknwon").status == 400,
+         "an unrecognized status filter must be rejected");
+  const auto import_jsonl = http.Post("/api/import/jsonl", jsonl.body + "\n{not json}\n",
+                                      {{"batch_size", "1"}}, "application/x-ndjson");
+  Assert(import_jsonl.status == 200, "import/jsonl status must be 200");
+  const auto import_report = nlohmann::json::parse(import_jsonl.body, nullptr, false);
+  Assert(import_report.value("imported", std::size_t{0}) == export_json.size(),
+         "import/jsonl should upsert every exported slug");
+  Assert(import_report.value("failed", 0) == 1, "import/jsonl should report the malformed line");
+  Assert(import_report.value("relationships_unresolved", 1) == 0,
+         "import/jsonl should resolve relationships across batches");
+
+  // Sequential requests share one pooled keep-alive connection, including from other threads.
+  std::vector<std::thread> callers;
+  for (int i = 0; i < 4; ++i) {
+    callers.emplace_back([&http] {
+      for (int j = 0; j < 5; ++j) {
+        Assert(http.Get("/api/health").status == 200, "pooled request must succeed");
+      }
+    });
+  }
+  for (auto& caller : callers) {
+    caller.join();
+  }
+  const auto opened = http.ConnectionsOpened();
+  for (int i = 0; i < 10; ++i) {
+    Assert(http.Get("/api/health").status == 200, "keep-alive request must succeed");
+  }
+  Assert(http.ConnectionsOpened() == opened && opened <= 4,
+         "HttpClient should reuse pooled keep-alive connections");
+
+  // The server's own /mcp endpoint runs tools through its handlers without a loopback request.
+  const nlohmann::json rpc_batch = nlohmann::json::array(
+      {{{"jsonrpc", "2.0"}, {"method", "notifications/initialized"}},
+       {{"jsonrpc", "2.0"},
+        {"id", 7},
+        {"method", "tools/call"},
+        {"params", {{"name", "apim.get_slug"}, {"arguments", {{"address_id", address_id}}}}}},
+       {{"jsonrpc", "2.0"}, {"id", 8}, {"method", "tools/call"}, {"params", {{"name", "nope"}}}}});
+  const auto rpc_response = http.Post("/mcp", rpc_batch.dump());
+  const auto rpc_json = nlohmann::json::parse(rpc_response.body, nullptr, false);
+  Assert(rpc_response.status == 200 && rpc_json.size() == 2 && rpc_json[0]["id"] == 7 &&
+             rpc_json[0]["result"]["content"][0]["text"].get<std::string>().find(address_id) !=
+                 std::string::npos &&
+             rpc_json[1]["error"]["code"] == -32000,
+         "/mcp should answer each request in a batch and skip notifications");
+
+  // Same-host callers can skip TCP: the Unix socket serves the same routes.
+  if (!unix_socket.empty()) {
+    platform::HttpClient local("unix://" + unix_socket);
+    const auto over_socket = local.Get("/api/slug/" + address_id);
+    Assert(over_socket.status == 200 && over_socket.body == http.Get("/api/slug/" + address_id).body,
+           "Unix socket should serve the same responses as TCP");
+    const auto mode = std::filesystem::status(unix_socket).permissions();
+    const auto rw = std::filesystem::perms::owner_read | std::filesystem::perms::owner_write |
+                    std::filesystem::perms::group_read | std::filesystem::perms::group_write;
+    Assert(mode == rw, "Unix socket should be created with mode 0660");
+
+    // A second server must neither steal a live socket nor delete a file that is not a socket.
+    const auto regular_file = unix_socket + ".file";
+    std::ofstream(regular_file) << "keep";
+    for (const auto& path : {unix_socket, regular_file}) {
+      platform::HttpServer clash;
+      clash.ListenOnUnixSocket(path);
+      bool refused = false;
+      try {
+        clash.Start("127.0.0.1", kTestPort + 2);
+      } catch (const std::exception&) {
+        refused = true;
+      }
+      Assert(refused, "Binding over an existing non-stale path should fail");
+    }
+    Assert(local.Get("/api/slug/" + address_id).status == 200 &&
+               std::filesystem::is_regular_file(regular_file),
+           "A refused Unix socket bind should leave the existing path alone");
+    std::filesystem::remove(regular_file);
+  }
+
+  // Compact output passes the body through; a byte budget keeps whole slugs and names the cursor
+  // that resumes the listing.
+  const auto full_export = bridge.CallTool("apim.export_json", nlohmann::json::object());
+  Assert(core::mcp::FormatResponseForDisplay(full_export, {/*compact=*/true, 0}) ==
+             "HTTP 200 (application/json)\n" + full_export.body,
+         "Compact output should return the body unchanged");
+  const auto all_slugs = nlohmann::json::parse(full_export.body);
+  const auto truncated = core::mcp::FormatResponseForDisplay(
+      full_export, {true, full_export.body.size() / 2, /*pageable=*/true});
+  const auto cursor_at = truncated.rfind("\"cursor\": \"");
+  Assert(all_slugs.size() > 2 && cursor_at != std::string::npos,
+         "Budgeted output should report a continuation cursor");
+  const auto cursor = truncated.substr(cursor_at + 11, truncated.find('"', cursor_at + 11) -
+                                                           cursor_at - 11);
+  const auto body_at = truncated.find('\n') + 1;
+  const auto kept = nlohmann::json::parse(
+      truncated.substr(body_at, truncated.find("\n[truncated") - body_at));
+  const auto resumed = nlohmann::json::parse(
+      bridge.CallTool("apim.export_json", {{"cursor", cursor}, {"limit", 1}}).body);
+  const auto position = core::DecodeSlugCursor(cursor);
+  Assert(!kept.empty() && kept.size() < all_slugs.size() && position &&
+             position->address_id == kept.back().value("address_id", "") &&
+             position->action == kept.back().value("action", "") && resumed.size() == 1 &&
+             resumed[0] == all_slugs[kept.size()],
+         "Cursor from truncated output should resume at the first dropped slug");
+
+  // Tools without a cursor argument (e.g. apim.update_slugs) are trimmed but never told to call
+  // again with one; CallToolContent decides pageability from the tool's schema.
+  nlohmann::json updated = nlohmann::json::array();
+  for (const auto& slug : all_slugs) {
+    updated.push_back({{"address_id", slug.value("address_id", "")}, {"status", "Pass"}});
+  }
+  const platform::HttpClientResponse update_slugs_reply{
+      200, "application/json", nlohmann::json{{"updated", updated}}.dump(), {}};
+  const auto trimmed_update = core::mcp::FormatResponseForDisplay(
+      update_slugs_reply, {true, update_slugs_reply.body.size() / 2});
+  const auto paged = bridge.CallToolContent({{"name", "apim.export_json"}},
+                                            {true, full_export.body.size() / 2});
+  const auto paged_text = paged["content"][0]["text"].get<std::string>();
+  Assert(trimmed_update.find("[truncated: showing") != std::string::npos &&
+             trimmed_update.find("cursor") == std::string::npos &&
+             paged_text.find("\"cursor\": \"") != std::string::npos,
+         "Only tools that accept a cursor should be offered one");
+
   server.Stop();
+
+  // Identical reads share the first caller's computation and its outcome, value or exception.
+  // A caller at a newer write generation never joins an older flight, and waiters rerun a
+  // computation that was cancelled instead of failing with it.
+  core::SingleFlight flights;
+  const auto run_flight = [&flights](const std::function<platform::HttpResponse(int)>& outcome) {
+    constexpr std::size_t kCallers = 4;
+    std::promise<void> gate;
+    const auto opened = gate.get_future().share();
+    std::atomic<int> runs{0};
+    const core::SingleFlight::Compute compute = [&] {
+      const int run = runs.fetch_add(1);
+      if (run == 0) {
+        opened.wait();
+      }
+      return outcome(run);
+    };
+    std::vector<std::string> results(kCallers);
+    std::vector<std::thread> callers;
+    for (std::size_t i = 0; i < kCallers; ++i) {
+      callers.emplace_back([&, i] {
+        try {
+          results[i] = flights.Do("/api/summary", 1, compute).body;
+        } catch (const core::OperationCancelled&) {
+          results[i] = "cancelled";
+        } catch (const std::exception& ex) {
+          results[i] = ex.what();
+        }
+      });
+      while (i == 0 && flights.Stats().in_flight == 0) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+      }
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+    const auto newer = flights.Do("/api/summary", 2, [] {
+      platform::HttpResponse response;
+      response.body = "newer";
+      return response;
+    });
+    gate.set_value();
+    for (auto& caller : callers) {
+      caller.join();
+    }
+    Assert(newer.body == "newer", "A newer write generation should not join an older flight");
+    return std::pair{results, runs.load()};
+  };
+  const auto [shared, shared_runs] = run_flight([](int) {
+    platform::HttpResponse response;
+    response.body = "value";
+    return response;
+  });
+  const auto coalesced = flights.Stats().coalesced;
+  const auto [failed, failed_runs] = run_flight([](int) -> platform::HttpResponse {
+    throw std::runtime_error("boom");
+  });
+  const auto [retried, retried_runs] = run_flight([](int run) {
+    if (run == 0) {
+      throw core::OperationCancelled("gone", /*deadline_exceeded=*/false);
+    }
+    platform::HttpResponse response;
+    response.body = "value";
+    return response;
+  });
+  const auto all_equal = [](const std::vector<std::string>& results, std::size_t from,
+                            const std::string& expected) {
+    return std::all_of(results.begin() + static_cast<std::ptrdiff_t>(from), results.end(),
+                       [&expected](const std::string& result) { return result == expected; });
+  };
+  Assert(shared_runs == 1 && all_equal(shared, 0, "value") && coalesced == 3 &&
+             failed_runs == 1 && all_equal(failed, 0, "boom") && flights.Stats().in_flight == 0,
+         "Identical concurrent calls should share one computation and its outcome");
+  Assert(retried_runs >= 2 && retried.front() == "cancelled" && all_equal(retried, 1, "value"),
+         "Waiters should rerun a cancelled computation");
+
+  // A waiter gives up at its own deadline or disconnect while the computation it joined runs on.
+  {
+    std::promise<void> gate;
+    const auto opened = gate.get_future().share();
+    std::thread leader([&] {
+      flights.Do("/api/export/json", 1, [&] {
+        opened.wait();
+        return platform::HttpResponse{};
+      });
+    });
+    while (flights.Stats().in_flight == 0) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    const auto wait_outcome = [&flights](const core::Cancellation& cancel) {
+      try {
+        flights.Do("/api/export/json", 1, [] { return platform::HttpResponse{}; }, cancel);
+        return std::string{"answered"};
+      } catch (const core::OperationCancelled& ex) {
+        return std::string{ex.deadline_exceeded() ? "deadline" : "abandoned"};
+      }
+    };
+    const auto started = std::chrono::steady_clock::now();
+    std::atomic<bool> gone{false};
+    auto timed_out = std::async(std::launch::async, wait_outcome,
+                                core::Cancellation{started + std::chrono::milliseconds(100), {}});
+    auto disconnected = std::async(
+        std::launch::async, wait_outcome,
+        core::Cancellation{std::chrono::steady_clock::time_point::max(), [&gone] {
+                             return gone.load();
+                           }});
+    std::this_thread::sleep_for(std::chrono::milliseconds(150));
+    gone = true;
+    const auto deadline_result = timed_out.get();
+    const auto abandoned_result = disconnected.get();
+    const auto waited = std::chrono::steady_clock::now() - started;
+    gate.set_value();
+    leader.join();
+    Assert(deadline_result == "deadline" && abandoned_result == "abandoned" &&
+               waited < std::chrono::seconds(2) && flights.Stats().in_flight == 0,
+           "A waiter should stop at its own deadline or disconnect");
+  }
+
+  // Exact routes beat the longest matching prefix, which beats a regex; a `(.+)` prefix with an
+  // empty remainder falls through to a shorter prefix. Preflight covers routed paths only.
+  platform::HttpServer routed;
+  const auto reply = [](std::string label) {
+    return [label](const platform::HttpRequest& request) {
+      platform::HttpResponse response;
+      response.body = label;
+      for (const auto& param : request.path_params) {
+        response.body += ":" + param;
+      }
+      return response;
+    };
+  };
+  routed.AddHandler(platform::HttpMethod::kGet, "/r/exact", reply("exact"));
+  routed.AddHandler(platform::HttpMethod::kGet, "/r/(.+)", reply("prefix"));
+  routed.AddHandler(platform::HttpMethod::kGet, "/r/deep/(.+)", reply("deep"));
+  routed.AddHandler(platform::HttpMethod::kGet, "/r/([a-z]+)/x", reply("regex"));
+  routed.AddHandler(platform::HttpMethod::kGet, "/q/([0-9]+)", reply("regex"));
+  routed.SetPreflightHandler([](const platform::HttpRequest&) {
+    platform::HttpResponse response;
+    response.status = 204;
+    return response;
+  });
+  const auto get = [&routed](const std::string& path) {
+    platform::HttpRequest request;
+    request.path = path;
+    const auto response = routed.Dispatch(platform::HttpMethod::kGet, request);
+    return response.status == 200 ? response.body : std::to_string(response.status);
+  };
+  const auto preflight = [&routed](const std::string& path) {
+    platform::HttpRequest request;
+    request.path = path;
+    return routed.Dispatch(platform::HttpMethod::kOptions, request).status;
+  };
+  Assert(get("/r/exact") == "exact" && get("/r/deep/a/b") == "deep:a/b" &&
+             get("/r/abc/x") == "prefix:abc/x" && get("/r/deep/") == "prefix:deep/" &&
+             get("/q/42") == "regex:42" && get("/r/") == "404" && get("/q/x") == "404",
+         "Router should prefer exact, then the longest prefix, then regex routes");
+  Assert(preflight("/r/exact") == 204 && preflight("/q/7") == 204 && preflight("/nowhere") == 404,
+         "Preflight should answer routed paths only");
+
+  // Once a client's bucket is empty, admission control answers 429 without running the handler.
+  platform::HttpServer limited;
+  int handled = 0;
+  limited.AddHandler(platform::HttpMethod::kGet, "/ping", [&handled](const platform::HttpRequest&) {
+    ++handled;
+    return platform::HttpResponse{};
+  });
+  limited.AddHandler(platform::HttpMethod::kGet, "/heavy", [](const platform::HttpRequest&) {
+    return platform::HttpResponse{};
+  }, platform::RouteClass::kHeavy);
+  std::atomic<int> uploads{0};
+  limited.AddHandler(platform::HttpMethod::kPost, "/upload",
+                     [&uploads](const platform::HttpRequest&) {
+                       ++uploads;
+                       return platform::HttpResponse{};
+                     });
+  platform::AdmissionPolicy policy;
+  policy.read = {/*per_second=*/0.01, /*burst=*/1};
+  policy.heavy = {/*per_second=*/0.01, /*burst=*/1};
+  limited.SetAdmissionPolicy(policy);
+  // Nested calls (e.g. /mcp tools) that ask for admission are charged to the outer client.
+  platform::HttpRequest nested;
+  nested.path = "/heavy";
+  nested.client = "127.0.0.9";
+  const auto nested_first = limited.Dispatch(platform::HttpMethod::kGet, nested, /*admit=*/true);
+  const auto nested_second = limited.Dispatch(platform::HttpMethod::kGet, nested, /*admit=*/true);
+  Assert(nested_first.status == 200 && nested_second.status == 429 &&
+             limited.Dispatch(platform::HttpMethod::kGet, nested).status == 200,
+         "Admitted Dispatch calls should be rate limited under the route's class");
+
+  // /mcp is not charged itself: a tool call spends one token of its target route's class only,
+  // so an /mcp write leaves the second write token for a direct PATCH.
+  {
+    const auto mcp_db =
+        (std::filesystem::temp_directory_path() / "apim-mcp-admission-test.db").string();
+    std::filesystem::remove(mcp_db);
+    {
+      core::ChecklistStore mcp_store(mcp_db);
+      mcp_store.Initialize(true);
+      core::ServerConfig config;
+      config.rate_write_per_second = 1;  // a bucket of 2 with the default 2 s burst
+      platform::HttpServer mcp_server;
+      core::ConfigureServer(mcp_server, mcp_store, config);
+      const auto seeded = mcp_store.ExportAllSlugs().front().address_id;
+      platform::HttpRequest rpc;
+      rpc.path = "/mcp";
+      rpc.client = "127.0.0.8";
+      rpc.body = nlohmann::json{{"jsonrpc", "2.0"},
+                                {"id", 1},
+                                {"method", "tools/call"},
+                                {"params",
+                                 {{"name", "apim.update_slug"},
+                                  {"arguments", {{"address_id", seeded}, {"comment", "mcp"}}}}}}
+                     .dump();
+      const auto rpc_reply = mcp_server.Dispatch(platform::HttpMethod::kPost, rpc, /*admit=*/true);
+      platform::HttpRequest patch;
+      patch.path = "/api/update";
+      patch.client = rpc.client;
+      patch.body = nlohmann::json{{"address_id", seeded}, {"comment", "direct"}}.dump();
+      const auto direct = mcp_server.Dispatch(platform::HttpMethod::kPatch, patch, /*admit=*/true);
+      const auto rpc_json = nlohmann::json::parse(rpc_reply.body, nullptr, false);
+      const auto rpc_text = rpc_json["result"]["content"][0]["text"].get<std::string>();
+      Assert(rpc_reply.status == 200 && rpc_text.rfind("HTTP 200", 0) == 0 &&
+                 direct.status == 200 && mcp_server.Admission().admitted[1] == 2,
+             "An /mcp write should charge the write bucket once");
+    }
+    std::filesystem::remove(mcp_db);
+  }
+  if (!unix_socket.empty()) {
+    LeaveStaleSocket(unix_socket);
+    limited.ListenOnUnixSocket(unix_socket);
+  }
+  std::thread listener([&limited] { limited.Start("127.0.0.1", kTestPort + 1); });
+  std::this_thread::sleep_for(std::chrono::milliseconds(200));
+  platform::HttpClient limited_client("http://127.0.0.1:" + std::to_string(kTestPort + 1));
+  const auto admitted = limited_client.Get("/ping");
+  const auto rejected = limited_client.Get("/ping");
+  // A body cut short by a disconnect, or a malformed one, never reaches the handler.
+  SendRawRequest(kTestPort + 1,
+                 "POST /upload HTTP/1.1\r\nHost: localhost\r\nContent-Length: 100\r\n\r\nshort",
+                 /*end_upload=*/true);
+  const auto bad_chunks = SendRawRequest(kTestPort + 1,
+                                         "POST /upload HTTP/1.1\r\nHost: localhost\r\n"
+                                         "Connection: close\r\nTransfer-Encoding: chunked\r\n"
+                                         "\r\nzz\r\n",
+                                         /*end_upload=*/false);
+  const auto whole_upload = limited_client.Post("/upload", "complete");
+  // Unix-socket peers share no address, so they are exempt from the per-client buckets.
+  int local_admitted = 0;
+  if (!unix_socket.empty()) {
+    platform::HttpClient local_client("unix://" + unix_socket);
+    for (int i = 0; i < 3; ++i) {
+      local_admitted += local_client.Get("/ping").status == 200 ? 1 : 0;
+    }
+  }
+  limited.Stop();
+  listener.join();
+  const auto retry_after = rejected.headers.find("Retry-After");
+  Assert(admitted.status == 200 && rejected.status == 429 &&
+             handled == 1 + local_admitted && retry_after != rejected.headers.end() &&
+             std::stoi(retry_after->second) >= 1 && limited.Admission().rate_limited[0] == 1,
+         "Rate-limited request should get 429 with Retry-After");
+  Assert(unix_socket.empty() || local_admitted == 3,
+         "Unix-socket clients should not be rate limited per client");
+#ifndef _WIN32
+  Assert(bad_chunks == "HTTP/1.1 400 Bad Request",
+         "A malformed request body should be answered 400");
+#endif
+  Assert(whole_upload.status == 200 && uploads == 1,
+         "Handlers should only run on a completely read body");
 }
 
 }  // namespace
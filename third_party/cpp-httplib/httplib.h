@@ -4,11 +4,16 @@
 //  Copyright (c) 2024 Yuji Hirose. All rights reserved.
 //  MIT License
 //
+//  Local patches (see patches/ next to this file; reapply or drop on every
+//  vendor bump):
+//    0001-request-is-connection-closed.patch - Request::is_connection_closed,
+//      backported from 0.20 (upstream has it natively from 0.20 on).
+//
 
 #ifndef CPPHTTPLIB_HTTPLIB_H
 #define CPPHTTPLIB_HTTPLIB_H
 
-#define CPPHTTPLIB_VERSION "0.15.3"
+#define CPPHTTPLIB_VERSION "0.15.3-apim.1"
 
 /*
  * Configuration
@@ -550,6 +555,9 @@ struct Request {
   Ranges ranges;
   Match matches;
   std::unordered_map<std::string, std::string> path_params;
+  // Backported from cpp-httplib 0.20: lets a handler notice a disconnected
+  // client.
+  std::function<bool()> is_connection_closed = []() { return true; };
 
   // for client
   ResponseHandler response_handler;
@@ -6670,6 +6678,9 @@ Server::process_request(Stream &strm, bool close_connection,
 
   strm.get_local_ip_and_port(req.local_addr, req.local_port);
   req.set_header("LOCAL_ADDR", req.local_addr);
+  req.is_connection_closed = [&]() {
+    return !detail::is_socket_alive(strm.socket());
+  };
   req.set_header("LOCAL_PORT", std::to_string(req.local_port));
 
   if (req.has_header("Range")) {